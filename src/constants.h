@@ -21,6 +21,7 @@ using namespace godot;
 // Engine Shortcuts
 #define RS RenderingServer::get_singleton()
 #define PS PhysicsServer3D::get_singleton()
+#define NS NavigationServer3D::get_singleton()
 #define IS_EDITOR Engine::get_singleton()->is_editor_hint()
 
 // Constants
@@ -16,14 +16,29 @@ vec3 get_displacement(vec2 pos, float scale) {
 	d_uv.x /= log2(_subdiv);
 	highp vec3 disp = vec3(0.);
 	if (all(greaterThanEqual(d_uv, vec2(0.0))) && all(lessThanEqual(d_uv, vec2(1.0)))) {
-		disp = textureLod(_displacement_buffer, d_uv, 0.).rgb * 2.0 - 1.0;
+		// Tiles are addressed toroidally, so filter manually to wrap within the tile. Texels are
+		// clamped to the tile's window, as those past its edges hold the opposite side.
+		float size = _mesh_size * 4.0;
+		vec2 origin = round(_target_pos.xz * _vertex_density * scale) * 2.0 - size * 0.5;
+		vec2 f = 2.0 * scale * pos - 0.5;
+		vec2 k = floor(f);
+		vec2 w = f - k;
+		vec2 k0 = mod(clamp(k, origin, origin + size - 1.0), size);
+		vec2 k1 = mod(clamp(k + 1.0, origin, origin + size - 1.0), size);
+		float tile = (s - 1.) * size;
+		highp vec3 d00 = texelFetch(_displacement_buffer, ivec2(int(tile + k0.x), int(k0.y)), 0).rgb;
+		highp vec3 d10 = texelFetch(_displacement_buffer, ivec2(int(tile + k1.x), int(k0.y)), 0).rgb;
+		highp vec3 d01 = texelFetch(_displacement_buffer, ivec2(int(tile + k0.x), int(k1.y)), 0).rgb;
+		highp vec3 d11 = texelFetch(_displacement_buffer, ivec2(int(tile + k1.x), int(k1.y)), 0).rgb;
+		disp = mix(mix(d00, d10, w.x), mix(d01, d11, w.x), w.y) * 2.0 - 1.0;
 		disp *= _displacement_scale;
 	}
 	return disp;
 }
 
 //INSERT: DISPLACEMENT_VERTEX
-		if (!(CAMERA_VISIBLE_LAYERS == _mouse_layer)) {
+		// The displacement buffer is centered on the main target
+		if (!(CAMERA_VISIBLE_LAYERS == _mouse_layer) && _clipmap_target.w < 0.5) {
 			displacement = mix(get_displacement(start_pos, scale), get_displacement(end_pos, scale * 2.0), vertex_lerp);
 		}
 
@@ -237,11 +237,15 @@ float get_height(vec2 index_id, vec2 offset) {
 
 		R"(
 void fragment() {
-	// Calculate Tiled UVs
+	// Calculate Tiled UVs. Tiles are addressed toroidally: texel k from the world origin is stored at
+	// mod(k, size), so only newly exposed strips are rendered as the target moves.
 	float scale = floor(UV.x * (_tessellation_level));
 	float p_scale = pow(2.0, scale);
-	vec2 uv = (vec2(fract(UV.x * _tessellation_level), UV.y) - 0.5) * (_mesh_size * 2.0) / p_scale;
-	uv += round(_target_pos.xz * _vertex_density * p_scale) / p_scale;
+	float size = _mesh_size * 4.0;
+	vec2 texel = floor(vec2(fract(UV.x * _tessellation_level), UV.y) * size);
+	vec2 window = round(_target_pos.xz * _vertex_density * p_scale) * 2.0 - _mesh_size * 2.0;
+	vec2 k = window + mod(texel - window, size);
+	vec2 uv = (k + 0.5) * 0.5 / p_scale;
 	vec2 uv2 = uv * _region_texel_size;
 
 	// Lookup offsets, ID and blend weight
@@ -44,7 +44,10 @@ render_mode blend_mix, depth_draw_opaque, cull_back, diffuse_burley, specular_sc
 // Private uniforms
 group_uniforms private;
 uniform vec3 _target_pos = vec3(0.f);
+// Set on clipmap rings of additional viewpoints to their own target. w = 1 when set
+instance uniform vec4 _clipmap_target = vec4(0.f);
 uniform float _mesh_size = 48.f;
+uniform float _cdlod_range = 0.f; // LOD0 morph range in world units, 0 for clipmap
 uniform float _subdiv = 1.f;
 uniform float _tessellation_level = 0.f;
 uniform uint _background_mode = 1u; // NONE = 0, FLAT = 1, NOISE = 2
@@ -171,17 +174,28 @@ void vertex() {
 	// Get vertex of flat plane in world coordinates and set world UV
 	v_vertex = (MODEL_MATRIX * vec4(VERTEX, 1.0)).xyz;
 
+	// Additional viewpoint rings geomorph around their own target
+	vec3 target_pos = _clipmap_target.w > 0.5 ? _clipmap_target.xyz : _target_pos;
+
 	// Distance from target node to vertex on a flat plane
-	v_vertex_xz_dist = length(v_vertex.xz - _target_pos.xz);
+	v_vertex_xz_dist = length(v_vertex.xz - target_pos.xz);
 
 	// Geomorph vertex across clipmap LODs, set end and start for linear height interpolate
 	float scale = MODEL_MATRIX[0][0];
 	float inv_scale = 1.0 / scale;
-	float max_xz = max(abs(v_vertex.x - _target_pos.x), abs(v_vertex.z - _target_pos.z));
+	float max_xz = max(abs(v_vertex.x - target_pos.x), abs(v_vertex.z - target_pos.z));
 	float vertex_lerp = smoothstep(0.0, 1.0, (max_xz * inv_scale - _mesh_size - 4.0) / (_mesh_size - 4.0));
+	// CDLOD tiles morph over the last quarter of their LOD range, by 3D distance to the target
+	bool cdlod = _cdlod_range > 0.0;
+	if (cdlod) {
+		float range = _cdlod_range * scale * _subdiv * _vertex_density;
+		float h0 = texelFetch(_height_maps, get_index_coord(v_vertex.xz * _vertex_density), 0).r;
+		float dist = length(vec3(v_vertex.x, h0, v_vertex.z) - target_pos);
+		vertex_lerp = clamp((dist - range * 0.75) * 4.0 / range, 0.0, 1.0);
+	}
 	vec2 vertex_fract = fract(VERTEX.xz * 0.5) * 2.0;
 	// For LOD0 morph from a regular grid to an alternating grid to align with LOD1+
-	vec2 shift = (scale < _vertex_spacing / _subdiv + 1e-6) ? // LOD0 or not
+	vec2 shift = (!cdlod && scale < _vertex_spacing / _subdiv + 1e-6) ? // LOD0 or not
 		// Shift from regular to symmetric
 		mix(vertex_fract, vec2(vertex_fract.x, -vertex_fract.y),
 			round(fract(round(mod(v_vertex.z * inv_scale, 4.0)) *
@@ -1,6 +1,8 @@
 // Copyright © 2023-2026 Cory Petkovsek, Roope Palmroos, and Contributors.
 
+#include <godot_cpp/classes/array_mesh.hpp>
 #include <godot_cpp/classes/compositor.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
 #include <godot_cpp/classes/directional_light3d.hpp>
 #include <godot_cpp/classes/editor_interface.hpp>
 #include <godot_cpp/classes/engine.hpp>
@@ -11,10 +13,14 @@
 #include <godot_cpp/classes/physics_ray_query_parameters3d.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/quad_mesh.hpp>
+#include <godot_cpp/classes/resource_saver.hpp>
 #include <godot_cpp/classes/shader_material.hpp>
-#include <godot_cpp/classes/surface_tool.hpp>
 #include <godot_cpp/classes/viewport_texture.hpp>
+#include <godot_cpp/classes/world2d.hpp>
 #include <godot_cpp/classes/world3d.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <vector>
 
 #include "logger.h"
 #include "terrain_3d.h"
@@ -50,6 +56,10 @@ void Terrain3D::_initialize() {
 		LOG(DEBUG, "Creating instancer");
 		_instancer = memnew(Terrain3DInstancer);
 	}
+	if (!_navigation) {
+		LOG(DEBUG, "Creating navigation manager");
+		_navigation = memnew(Terrain3DNavigation);
+	}
 	// Connect signals
 	// Any region was changed, update region labels
 	if (!_data->is_connected("region_map_changed", callable_mp(this, &Terrain3D::update_region_labels))) {
@@ -66,10 +76,64 @@ void Terrain3D::_initialize() {
 		LOG(DEBUG, "Connecting _data::maps_changed signal to _material->_update()");
 		_data->connect("maps_changed", callable_mp(_material.ptr(), &Terrain3DMaterial::update).bind(Terrain3DMaterial::REGION_ARRAYS));
 	}
-	// Height map was regenerated, update aabbs
-	if (!_data->is_connected("height_maps_changed", callable_mp(this, &Terrain3D::_update_mesher_aabbs))) {
-		LOG(DEBUG, "Connecting _data::height_maps_changed signal to update_aabbs()");
-		_data->connect("height_maps_changed", callable_mp(this, &Terrain3D::_update_mesher_aabbs));
+	// Height map was changed, update aabbs at the end of the frame
+	if (!_data->is_connected("height_maps_changed", callable_mp(this, &Terrain3D::_mark_mesher_aabbs_dirty))) {
+		LOG(DEBUG, "Connecting _data::height_maps_changed signal to _mark_mesher_aabbs_dirty()");
+		_data->connect("height_maps_changed", callable_mp(this, &Terrain3D::_mark_mesher_aabbs_dirty));
+	}
+	// Maps were regenerated or regions changed, update all aabbs
+	if (!_data->is_connected("maps_changed", callable_mp(this, &Terrain3D::_mark_mesher_aabbs_full))) {
+		LOG(DEBUG, "Connecting _data::maps_changed signal to _mark_mesher_aabbs_full()");
+		_data->connect("maps_changed", callable_mp(this, &Terrain3D::_mark_mesher_aabbs_full));
+	}
+	// Terrain was edited, update aabbs over the edited area
+	if (!_data->is_connected("maps_edited", callable_mp(this, &Terrain3D::_mark_mesher_aabbs_edited))) {
+		LOG(DEBUG, "Connecting _data::maps_edited signal to _mark_mesher_aabbs_edited()");
+		_data->connect("maps_edited", callable_mp(this, &Terrain3D::_mark_mesher_aabbs_edited));
+	}
+	// Terrain was edited, invalidate navigation source geometry cached there
+	if (!_data->is_connected("maps_edited", callable_mp(this, &Terrain3D::_invalidate_nav_cache))) {
+		LOG(DEBUG, "Connecting _data::maps_edited signal to _invalidate_nav_cache()");
+		_data->connect("maps_edited", callable_mp(this, &Terrain3D::_invalidate_nav_cache));
+	}
+	// Any region was changed, clear the navigation cache
+	if (!_data->is_connected("region_map_changed", callable_mp(this, &Terrain3D::clear_nav_cache))) {
+		LOG(DEBUG, "Connecting _data::region_map_changed signal to clear_nav_cache()");
+		_data->connect("region_map_changed", callable_mp(this, &Terrain3D::clear_nav_cache));
+	}
+	// Terrain was edited, rebake navigation tiles there
+	if (!_data->is_connected("maps_edited", callable_mp(_navigation, &Terrain3DNavigation::invalidate))) {
+		LOG(DEBUG, "Connecting _data::maps_edited signal to _navigation->invalidate()");
+		_data->connect("maps_edited", callable_mp(_navigation, &Terrain3DNavigation::invalidate));
+	}
+	// Maps were regenerated or regions changed, rebake all navigation tiles
+	if (!_data->is_connected("maps_changed", callable_mp(_navigation, &Terrain3DNavigation::rebake))) {
+		LOG(DEBUG, "Connecting _data::maps_changed signal to _navigation->rebake()");
+		_data->connect("maps_changed", callable_mp(_navigation, &Terrain3DNavigation::rebake));
+	}
+	// Maps were regenerated or regions changed, rebuild all occluders
+	if (!_data->is_connected("maps_changed", callable_mp(this, &Terrain3D::_mark_occluders_dirty))) {
+		LOG(DEBUG, "Connecting _data::maps_changed signal to _mark_occluders_dirty()");
+		_data->connect("maps_changed", callable_mp(this, &Terrain3D::_mark_occluders_dirty));
+	}
+	// Terrain was edited, rebuild occluders of the regions there
+	if (!_data->is_connected("maps_edited", callable_mp(this, &Terrain3D::_invalidate_occluders))) {
+		LOG(DEBUG, "Connecting _data::maps_edited signal to _invalidate_occluders()");
+		_data->connect("maps_edited", callable_mp(this, &Terrain3D::_invalidate_occluders));
+	}
+	// Height or control maps were changed, rerender the displacement buffer
+	if (!_data->is_connected("height_maps_changed", callable_mp(this, &Terrain3D::clear_displacement_buffer))) {
+		LOG(DEBUG, "Connecting _data::height_maps_changed signal to clear_displacement_buffer()");
+		_data->connect("height_maps_changed", callable_mp(this, &Terrain3D::clear_displacement_buffer));
+	}
+	if (!_data->is_connected("control_maps_changed", callable_mp(this, &Terrain3D::clear_displacement_buffer))) {
+		LOG(DEBUG, "Connecting _data::control_maps_changed signal to clear_displacement_buffer()");
+		_data->connect("control_maps_changed", callable_mp(this, &Terrain3D::clear_displacement_buffer));
+	}
+	// Terrain was edited, rerender the displacement buffer tiles there
+	if (!_data->is_connected("maps_edited", callable_mp(this, &Terrain3D::_invalidate_displacement_buffer))) {
+		LOG(DEBUG, "Connecting _data::maps_edited signal to _invalidate_displacement_buffer()");
+		_data->connect("maps_edited", callable_mp(this, &Terrain3D::_invalidate_displacement_buffer));
 	}
 	// Texture assets changed, update material uniforms without rebuilding shaders
 	if (!_assets->is_connected("textures_changed", callable_mp(_material.ptr(), &Terrain3DMaterial::update).bind(Terrain3DMaterial::TEXTURE_ARRAYS))) {
@@ -84,9 +148,11 @@ void Terrain3D::_initialize() {
 		_assets->initialize(this);
 		_collision->initialize(this);
 		_instancer->initialize(this);
+		_navigation->initialize(this);
 		_setup_terrain_mesher();
 		_setup_ocean_mesher();
 		_update_displacement_buffer();
+		_mark_occluders_dirty();
 		_initialized = true;
 		snap();
 	}
@@ -97,6 +163,19 @@ void Terrain3D::_initialize() {
  * This is a proxy for _process(delta) called by _notification() due to
  * https://github.com/godotengine/godot-cpp/issues/1022
  */
+void Terrain3D::__process(const double p_delta) {
+	if (!_initialized) {
+		return;
+	}
+	if (_clipmap_update_mode == CLIPMAP_UPDATE_PROCESS) {
+		_update_clipmap();
+	}
+}
+
+/**
+ * This is a proxy for _physics_process(delta) called by _notification() due to
+ * https://github.com/godotengine/godot-cpp/issues/1022
+ */
 void Terrain3D::__physics_process(const double p_delta) {
 	if (!_initialized) {
 		return;
@@ -105,6 +184,30 @@ void Terrain3D::__physics_process(const double p_delta) {
 		LOG(DEBUG, "Camera is null, getting the current one");
 		_grab_camera();
 	}
+	if (_clipmap_update_mode == CLIPMAP_UPDATE_PHYSICS) {
+		_update_clipmap();
+	}
+	if (_collision && _collision->is_dynamic_mode()) {
+		_collision->update();
+	}
+	if (_occlusion_enabled && _occluders_dirty) {
+		_update_occluders();
+	}
+	if (_navigation && _navigation->is_enabled()) {
+		_navigation->update();
+	}
+}
+
+// Clipmap updates run at the rate chosen by clipmap_update_mode. Collision, occlusion and
+// navigation always run at the physics rate.
+void Terrain3D::_set_processing(const bool p_enabled) {
+	set_physics_process(p_enabled);
+	set_process(p_enabled && _clipmap_update_mode == CLIPMAP_UPDATE_PROCESS);
+}
+
+// Snaps the meshes and displacement buffer to their targets and updates the light
+void Terrain3D::_update_clipmap() {
+	_clipmap_updates++;
 	if (_tessellation_level > 0) {
 		if (_terrain_mesher && _d_buffer_vp && _material.is_valid()) {
 			// If clipmap target has moved enough, re-center buffer on the target.
@@ -114,7 +217,7 @@ void Terrain3D::__physics_process(const double p_delta) {
 			if (!(MAX(std::abs(_last_buffer_position.x - target_pos_2d.x), std::abs(_last_buffer_position.y - target_pos_2d.y)) < vertex_spacing)) {
 				_last_buffer_position = target_pos_2d;
 				RS->material_set_param(_material->get_buffer_material_rid(), "_target_pos", get_clipmap_target_position());
-				_d_buffer_vp->set_update_mode(SubViewport::UPDATE_ONCE);
+				_render_displacement_buffer(get_clipmap_target_position());
 				// Only call snap on _mesher if the buffer has snapped, prevents stuttering.
 				_terrain_mesher->snap();
 			}
@@ -122,29 +225,48 @@ void Terrain3D::__physics_process(const double p_delta) {
 	} else if (_terrain_mesher) {
 		_terrain_mesher->snap();
 	}
+	// Remove rings whose viewpoint was freed
+	for (int i = int(_viewpoint_meshers.size()) - 1; i >= 0; i--) {
+		Terrain3DMesher *mesher = _viewpoint_meshers[i];
+		if (!mesher->get_viewpoint_target()) {
+			LOG(INFO, "Clipmap viewpoint freed, removing its ring");
+			delete mesher;
+			_viewpoint_meshers.erase(_viewpoint_meshers.begin() + i);
+			continue;
+		}
+		mesher->snap();
+	}
 	if (_ocean_enabled && _ocean_mesher) {
 		_ocean_mesher->snap();
 	}
-	if (_light_target.is_valid()) {
-		DirectionalLight3D *light = cast_to<DirectionalLight3D>(_light_target.ptr());
-		if (light) {
-			Color color = light->get_color() * light->get_param(DirectionalLight3D::PARAM_ENERGY);
-			Vector3 direction = light->get_global_basis().get_column(2);
-			if (_material.is_valid()) {
-				_material->set_shader_param("_light_color", color);
-				_material->set_shader_param("_light_direction", direction);
-			}
-			if (_ocean_material.is_valid()) {
-				ShaderMaterial *ocean_shader_mat = Object::cast_to<ShaderMaterial>(_ocean_material.ptr());
-				if (ocean_shader_mat) {
-					ocean_shader_mat->set_shader_parameter("_light_color", color);
-					ocean_shader_mat->set_shader_parameter("_light_direction", direction);
-				}
-			}
-		}
+	_update_light();
+}
+
+// Sends the light target's color and direction to the materials if they changed
+void Terrain3D::_update_light() {
+	DirectionalLight3D *light = cast_to<DirectionalLight3D>(_light_target.ptr());
+	if (!light) {
+		return;
 	}
-	if (_collision && _collision->is_dynamic_mode()) {
-		_collision->update();
+	const Color color = light->get_color() * light->get_param(DirectionalLight3D::PARAM_ENERGY);
+	const Vector3 direction = light->get_global_basis().get_column(2);
+	if (color == _light_color && direction == _light_direction) {
+		_light_updates_skipped++;
+		return;
+	}
+	_light_color = color;
+	_light_direction = direction;
+	_light_updates++;
+	if (_material.is_valid()) {
+		_material->set_shader_param("_light_color", color);
+		_material->set_shader_param("_light_direction", direction);
+	}
+	if (_ocean_material.is_valid()) {
+		ShaderMaterial *ocean_shader_mat = Object::cast_to<ShaderMaterial>(_ocean_material.ptr());
+		if (ocean_shader_mat) {
+			ocean_shader_mat->set_shader_parameter("_light_color", color);
+			ocean_shader_mat->set_shader_parameter("_light_direction", direction);
+		}
 	}
 }
 
@@ -161,7 +283,7 @@ void Terrain3D::_grab_camera() {
 		LOG(DEBUG, "Grabbing the in-game viewport camera: ", _camera.get_target());
 	}
 	if (!_camera.is_valid() && !_clipmap_target.is_valid()) {
-		set_physics_process(false); // No target to follow, disable snapping until one set
+		_set_processing(false); // No target to follow, disable snapping until one set
 		LOG(ERROR, "Cannot find clipmap target or active camera. LODs won't be updated. Set manually with set_clipmap_target() or set_camera()");
 	}
 }
@@ -176,16 +298,100 @@ void Terrain3D::_destroy_collision(const bool p_final) {
 	}
 }
 
+void Terrain3D::_destroy_navigation(const bool p_final) {
+	LOG(INFO, "Destroying Navigation");
+	if (_navigation) {
+		_navigation->destroy();
+	}
+	if (p_final) {
+		memdelete_safely(_navigation);
+	}
+}
+
 void Terrain3D::_setup_terrain_mesher() {
 	if (!_terrain_mesher) {
 		LOG(DEBUG, "Creating mesher");
 		_terrain_mesher = new Terrain3DMesher();
 	}
-	_terrain_mesher->initialize(this, _mesh_size, _mesh_lods, _tessellation_level, _vertex_spacing, _material->get_material_rid(), _render_layers);
+	_terrain_mesher->set_cdlod(_mesh_mode == MESH_MODE_CDLOD);
+	_terrain_mesher->set_cdlod_lod_distance(_cdlod_lod_distance);
+	_terrain_mesher->initialize(this, _mesh_size, _mesh_lods, _tessellation_level, _vertex_spacing, _material->get_material_rid(), _render_layers, _multimesh_enabled);
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->initialize_viewpoint(_terrain_mesher);
+	}
+}
+
+void Terrain3D::_update_terrain_meshers() {
+	if (_terrain_mesher) {
+		_terrain_mesher->update();
+	}
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->update();
+	}
+}
+
+void Terrain3D::_update_mesher_aabbs() {
+	if (_terrain_mesher) {
+		_terrain_mesher->update_aabbs();
+	}
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->update_aabbs();
+	}
+}
+
+// Queues a refresh of the mesher AABBs at the end of the frame, so signals emitted for each edited region
+// result in one refresh. Without an edited area, all instances are refreshed.
+void Terrain3D::_mark_mesher_aabbs_dirty() {
+	if (!_mesher_aabbs_dirty) {
+		_mesher_aabbs_dirty = true;
+		callable_mp(this, &Terrain3D::_refresh_mesher_aabbs).call_deferred();
+	}
+}
+
+void Terrain3D::_mark_mesher_aabbs_full() {
+	_mesher_aabbs_full = true;
+	_mark_mesher_aabbs_dirty();
+}
+
+void Terrain3D::_mark_mesher_aabbs_edited(const AABB &p_global_aabb) {
+	const Rect2 area = Rect2(p_global_aabb.position.x, p_global_aabb.position.z, p_global_aabb.size.x, p_global_aabb.size.z);
+	_mesher_aabbs_area = _mesher_aabbs_area.has_area() ? _mesher_aabbs_area.merge(area) : area;
+	_mark_mesher_aabbs_dirty();
+}
+
+void Terrain3D::_refresh_mesher_aabbs() {
+	if (!_mesher_aabbs_dirty) {
+		return;
+	}
+	const Rect2 area = _mesher_aabbs_full ? Rect2() : _mesher_aabbs_area;
+	_mesher_aabbs_dirty = false;
+	_mesher_aabbs_full = false;
+	_mesher_aabbs_area = Rect2();
+	if (!area.has_area()) {
+		_update_mesher_aabbs();
+		return;
+	}
+	LOG(DEBUG, "Updating mesher AABBs over ", area);
+	if (_terrain_mesher) {
+		_terrain_mesher->update_aabbs(-1.f, V2_MAX, area);
+	}
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->update_aabbs(-1.f, V2_MAX, area);
+	}
 }
 
 void Terrain3D::_destroy_terrain_mesher(const bool p_final) {
 	LOG(INFO, "Destroying terrain mesher");
+	// Viewpoint rings use the terrain mesher's meshes, so go first
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->destroy();
+		if (p_final) {
+			delete mesher;
+		}
+	}
+	if (p_final) {
+		_viewpoint_meshers.clear();
+	}
 	if (_terrain_mesher) {
 		_terrain_mesher->destroy();
 		if (p_final) {
@@ -239,33 +445,146 @@ void Terrain3D::_setup_displacement_buffer() {
 	_d_buffer_vp->set_size(Vector2i(2, 2));
 	_d_buffer_vp->set_disable_3d(true);
 	_d_buffer_vp->set_update_mode(SubViewport::UPDATE_ONCE);
+	// Texels outside of the rendered strips are kept
+	_d_buffer_vp->set_clear_mode(SubViewport::CLEAR_MODE_NEVER);
 	_d_buffer_vp->set_disable_input(true);
 	_d_buffer_vp->set_default_canvas_item_texture_filter(Viewport::DEFAULT_CANVAS_ITEM_TEXTURE_FILTER_NEAREST);
 
-	_d_buffer_rect = memnew(ColorRect);
-	_d_buffer_rect->set_name("DBufferRect");
-	_d_buffer_vp->add_child(_d_buffer_rect, true);
-	_d_buffer_rect->set_anchors_preset(Control::PRESET_FULL_RECT);
+	_d_buffer_canvas_item = RS->canvas_item_create();
+	RS->canvas_item_set_parent(_d_buffer_canvas_item, _d_buffer_vp->get_world_2d()->get_canvas());
+	_d_buffer_origins.clear();
 }
 
 void Terrain3D::_update_displacement_buffer() {
 	if (!_d_buffer_vp) {
 		return;
 	}
+	// Resizing discards the contents
+	_d_buffer_origins.clear();
+	_last_buffer_position = V2_MAX;
 	if (_tessellation_level == 0) {
 		_d_buffer_vp->set_size(V2I_ZERO);
-		_d_buffer_rect->set_size(V2I_ZERO);
+		RS->canvas_item_clear(_d_buffer_canvas_item);
 	} else {
 		_d_buffer_vp->set_size(Vector2i(_mesh_size * 4 * _tessellation_level, _mesh_size * 4));
-		_d_buffer_rect->set_size(Vector2i(_mesh_size * 4 * _tessellation_level, _mesh_size * 4));
 		LOG(INFO, "Updating displacement buffer to Size: ", _d_buffer_vp->get_size());
 		if (_material.is_valid() && _material->get_material_rid().is_valid()) {
-			RS->canvas_item_set_material(_d_buffer_rect->get_canvas_item(), _material->get_buffer_material_rid());
+			RS->canvas_item_set_material(_d_buffer_canvas_item, _material->get_buffer_material_rid());
 			RS->material_set_param(_material->get_material_rid(), "_displacement_buffer", _d_buffer_vp->get_texture()->get_rid());
 		}
 	}
 }
 
+// Renders the texels of each displacement buffer tile that the target moved into. A tile covers
+// size x size texels at half its LOD's vertex spacing. Texel k, counted from the world origin, is
+// stored at mod(k, size), so a texel's contents stay valid until it leaves the tile's window.
+void Terrain3D::_render_displacement_buffer(const Vector3 &p_target_pos) {
+	if (!_d_buffer_vp || _tessellation_level == 0) {
+		return;
+	}
+	const int size = _mesh_size * 4;
+	const Vector2 buffer_size = Vector2(size * _tessellation_level, size);
+	_d_buffer_origins.resize(_tessellation_level, V2I_MAX);
+	RS->canvas_item_clear(_d_buffer_canvas_item);
+	int rect_count = 0;
+
+	// Splits a range of texels where it wraps around the tile
+	auto split = [size](const int p_start, const int p_end, Vector2i *r_ranges) -> int {
+		const int start = ((p_start % size) + size) % size;
+		const int end = start + p_end - p_start;
+		if (end <= size) {
+			r_ranges[0] = Vector2i(start, end);
+			return 1;
+		}
+		r_ranges[0] = Vector2i(start, size);
+		r_ranges[1] = Vector2i(0, end - size);
+		return 2;
+	};
+	// Draws texels [p_start, p_end) of a tile. UVs match a full buffer rect, as the shader expects
+	PackedColorArray colors;
+	colors.push_back(Color(1.f, 1.f, 1.f, 1.f));
+	auto draw = [&](const int p_tile, const Vector2i &p_start, const Vector2i &p_end) {
+		Vector2i x_ranges[2];
+		Vector2i y_ranges[2];
+		const int x_count = split(p_start.x, p_end.x, x_ranges);
+		const int y_count = split(p_start.y, p_end.y, y_ranges);
+		for (int y = 0; y < y_count; y++) {
+			for (int x = 0; x < x_count; x++) {
+				const Vector2 start = Vector2(p_tile * size + x_ranges[x].x, y_ranges[y].x);
+				const Vector2 end = Vector2(p_tile * size + x_ranges[x].y, y_ranges[y].y);
+				const Vector2 corners[4] = { start, Vector2(end.x, start.y), end, Vector2(start.x, end.y) };
+				PackedVector2Array points;
+				PackedVector2Array uvs;
+				for (const Vector2 &corner : corners) {
+					points.push_back(corner);
+					uvs.push_back(corner / buffer_size);
+				}
+				RS->canvas_item_add_primitive(_d_buffer_canvas_item, points, colors, uvs, RID());
+				rect_count++;
+			}
+		}
+	};
+
+	// Strips are grown by a texel pair to cover rounding differences with the shader
+	const int margin = 2;
+	for (int tile = 0; tile < _tessellation_level; tile++) {
+		const real_t scale = pow(2.f, real_t(tile));
+		const Vector2 center = (v3v2(p_target_pos) / _vertex_spacing * scale).round();
+		const Vector2i origin = Vector2i(center) * 2 - V2I(size / 2);
+		const Vector2i last = _d_buffer_origins[tile];
+		_d_buffer_origins[tile] = origin;
+		const Vector2i end = origin + V2I(size);
+		if (last == V2I_MAX || std::abs(origin.x - last.x) >= size || std::abs(origin.y - last.y) >= size) {
+			draw(tile, origin, end);
+			continue;
+		}
+		// Columns entering the window, full height
+		if (origin.x > last.x) {
+			draw(tile, Vector2i(MAX(last.x + size - margin, origin.x), origin.y), end);
+		} else if (origin.x < last.x) {
+			draw(tile, origin, Vector2i(MIN(last.x + margin, end.x), end.y));
+		}
+		// Rows entering the window, full width
+		if (origin.y > last.y) {
+			draw(tile, Vector2i(origin.x, MAX(last.y + size - margin, origin.y)), end);
+		} else if (origin.y < last.y) {
+			draw(tile, origin, Vector2i(end.x, MIN(last.y + margin, end.y)));
+		}
+	}
+	if (rect_count > 0) {
+		LOG(EXTREME, "Rendering ", rect_count, " displacement buffer strips");
+		_d_buffer_vp->set_update_mode(SubViewport::UPDATE_ONCE);
+	}
+}
+
+// Discards the rendered contents of all tiles, so the next update renders them in full
+void Terrain3D::clear_displacement_buffer() {
+	_d_buffer_origins.clear();
+	_last_buffer_position = V2_MAX;
+}
+
+// Discards the rendered contents of tiles whose window overlaps the edited area
+void Terrain3D::_invalidate_displacement_buffer(const AABB &p_global_aabb) {
+	if (_tessellation_level == 0 || _d_buffer_origins.empty()) {
+		return;
+	}
+	const int size = _mesh_size * 4;
+	const Rect2 area = Rect2(p_global_aabb.position.x, p_global_aabb.position.z, p_global_aabb.size.x, p_global_aabb.size.z);
+	for (int tile = 0; tile < int(_d_buffer_origins.size()); tile++) {
+		const Vector2i origin = _d_buffer_origins[tile];
+		if (origin == V2I_MAX) {
+			continue;
+		}
+		// Texels are spaced at half the tile's LOD vertex spacing, grown by one for filtering
+		const real_t texel = _vertex_spacing / (2.f * pow(2.f, real_t(tile)));
+		const Rect2 window = Rect2(Vector2(origin - V2I(1)) * texel, Vector2(V2I(size + 2)) * texel);
+		if (window.intersects(area, true)) {
+			_d_buffer_origins[tile] = V2I_MAX;
+			_last_buffer_position = V2_MAX;
+		}
+	}
+}
+
 void Terrain3D::_build_containers() {
 	_label_parent = memnew(Node3D);
 	_label_parent->set_name("Labels");
@@ -286,8 +605,12 @@ void Terrain3D::_destroy_labels() {
 }
 
 void Terrain3D::_destroy_displacement_buffer() {
-	LOG(DEBUG, "Freeing d_buffer_rect");
-	memdelete_safely(_d_buffer_rect);
+	LOG(DEBUG, "Freeing d_buffer_canvas_item");
+	if (_d_buffer_canvas_item.is_valid()) {
+		RS->free_rid(_d_buffer_canvas_item);
+		_d_buffer_canvas_item = RID();
+	}
+	_d_buffer_origins.clear();
 	LOG(DEBUG, "Freeing d_buffer_vp");
 	memdelete_safely(_d_buffer_vp);
 }
@@ -368,124 +691,890 @@ void Terrain3D::_destroy_instancer() {
 	memdelete_safely(_instancer);
 }
 
-void Terrain3D::_generate_triangles(PackedVector3Array &p_vertices, PackedVector2Array *p_uvs, const int32_t p_lod,
-		const Terrain3DData::HeightFilter p_filter, const bool p_require_nav, const AABB &p_global_aabb) const {
+Array Terrain3D::MeshArrays::get_surface_arrays() const {
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	arrays[Mesh::ARRAY_VERTEX] = vertices;
+	if (normals.size() == vertices.size()) {
+		arrays[Mesh::ARRAY_NORMAL] = normals;
+	}
+	if (tangents.size() == vertices.size() * 4) {
+		arrays[Mesh::ARRAY_TANGENT] = tangents;
+	}
+	if (uvs.size() == vertices.size()) {
+		arrays[Mesh::ARRAY_TEX_UV] = uvs;
+	}
+	arrays[Mesh::ARRAY_INDEX] = indices;
+	return arrays;
+}
+
+/**
+ * Appends an indexed grid of triangles covering p_area to r_arrays, reading the maps directly.
+ * p_area: Descaled area of quads, eg. a region. Quads start every 2^p_lod vertices from p_area.position.
+ * Vertex heights match Terrain3DData::get_mesh_vertex(). There are no triangles over holes, edge heights are
+ * duplicated where the neighbor is missing, and with p_require_nav, only navigable triangles are kept.
+ * Vertices are shared between triangles, and those unused by any triangle are dropped.
+ * Rows are processed on the WorkerThreadPool, or serially if called from a pool task.
+ * p_attributes: Also generates uvs, tangents, and normals from central differences of the vertex heights.
+ * p_max_error: If > 0 and p_area is a square, power of 2 number of quads, simplifies the grid with
+ *  _triangulate_rtin(), keeping the surface within this vertical distance of the uniform grid.
+ * p_height_range: Quads are only generated where the height of the upper left vertex is within this range.
+ */
+void Terrain3D::_generate_grid(MeshArrays &r_arrays, const Rect2i &p_area, const int32_t p_lod,
+		const Terrain3DData::HeightFilter p_filter, const bool p_require_nav, const bool p_attributes,
+		const real_t p_max_error, const Vector2 &p_height_range) const {
 	ERR_FAIL_COND(_data == nullptr);
-	int32_t step = 1 << CLAMP(p_lod, 0, 8);
+	if (!p_area.has_area()) {
+		return;
+	}
+	const int32_t step = 1 << CLAMP(p_lod, 0, 8);
+	const int32_t half = (p_filter == Terrain3DData::HEIGHT_FILTER_MINIMUM) ? step / 2 : 0;
+	const int32_t quads_x = (p_area.size.x + step - 1) / step;
+	const int32_t quads_z = (p_area.size.y + step - 1) / step;
+
+	// Vertex grid with a one vertex border all around, used for edges and normals
+	const int32_t grid_w = quads_x + 3;
+	const int32_t grid_h = quads_z + 3;
+	auto gidx = [grid_w](const int32_t p_x, const int32_t p_z) -> int64_t {
+		return int64_t(p_z + 1) * grid_w + p_x + 1;
+	};
+
+	// Read the maps once, covering the grid
+	const int32_t win_w = (quads_x + 2) * step + 1;
+	const int32_t win_h = (quads_z + 2) * step + 1;
+	const Rect2i window = Rect2i(p_area.position - V2I(step), Vector2i(win_w, win_h));
+	std::vector<float> heights(int64_t(win_w) * win_h);
+	std::vector<float> controls(int64_t(win_w) * win_h);
+	_data->read_map_rect(TYPE_HEIGHT, window, heights.data());
+	_data->read_map_rect(TYPE_CONTROL, window, controls.data());
+	auto widx = [&](const int32_t p_x, const int32_t p_z) -> int64_t {
+		return int64_t((p_z + 1) * step) * win_w + (p_x + 1) * step;
+	};
+
+	// The minimum filter reads the region minimum height pyramids in blocks of half a step, so each vertex
+	// window is a few blocks regardless of lod
+	int32_t level = 0;
+	while ((2 << level) < step && (2 << level) <= _data->get_region_size()) {
+		level++;
+	}
+	const int32_t block = 1 << level;
+	Rect2i blocks;
+	std::vector<float> mins;
+	if (half > 0) {
+		const Vector2i min_start = window.position - V2I(half);
+		const Vector2i min_end = window.get_end() + V2I(half);
+		blocks.position = V2I_DIVIDE_FLOOR(min_start, block);
+		blocks.size = V2I_DIVIDE_CEIL(min_end, block) - blocks.position;
+		mins.resize(blocks.get_area());
+		_data->read_min_height_rect(level, blocks, mins.data());
+	}
+
+	// Vertex heights per get_mesh_vertex(). Missing pixels have a control of UINT32_MAX, which reads as a hole
+	std::vector<float> raw(int64_t(grid_w) * grid_h);
+	parallel_for(grid_h, [&](const int p_row) {
+		const int32_t z = p_row - 1;
+		for (int32_t x = -1; x <= quads_x + 1; x++) {
+			float height;
+			if (half > 0) {
+				const Vector2i pos = p_area.position + Vector2i(x, z) * step;
+				const Vector2i lo = pos - V2I(half);
+				const Vector2i hi = pos + V2I(half);
+				const Vector2i b_start = V2I_DIVIDE_FLOOR(lo, block) - blocks.position;
+				const Vector2i b_end = V2I_DIVIDE_CEIL(hi, block) - blocks.position;
+				height = FLT_MAX;
+				for (int32_t bz = b_start.y; bz < b_end.y && !std::isnan(height); bz++) {
+					for (int32_t bx = b_start.x; bx < b_end.x; bx++) {
+						const float h = mins[int64_t(bz) * blocks.size.x + bx];
+						if (std::isnan(h)) {
+							height = NAN;
+							break;
+						}
+						height = MIN(height, h);
+					}
+				}
+			} else {
+				const int64_t c = widx(x, z);
+				height = is_hole(controls[c]) ? NAN : heights[c];
+			}
+			raw[gidx(x, z)] = height;
+		}
+	});
+
+	// If on the region edge, duplicate the edge heights from the left, upper, or upper left vertex
+	std::vector<float> resolved(raw.size(), NAN);
+	parallel_for(grid_h - 1, [&](const int p_row) {
+		const int32_t z = p_row;
+		for (int32_t x = 0; x <= quads_x + 1; x++) {
+			float height = raw[gidx(x, z)];
+			if (std::isnan(height)) {
+				height = raw[gidx(x - 1, z)];
+			}
+			if (std::isnan(height)) {
+				height = raw[gidx(x, z - 1)];
+			}
+			if (std::isnan(height)) {
+				height = raw[gidx(x - 1, z - 1)];
+			}
+			resolved[gidx(x, z)] = height;
+		}
+	});
+
+	// Triangles per quad: bit 0 is the bottom 143 triangle, bit 1 the top 124
+	//		1  __  2
+	//		  |\ |
+	//		  | \|
+	//		3  --  4
+	// Holes are only where the control map is valid and the bit is set. Navigation is where the control map
+	// is valid and the bit is set, or it's the region edge and nav1 is set.
+	std::vector<uint8_t> tris(int64_t(quads_x) * quads_z);
+	std::vector<int32_t> tri_rows(quads_z + 1, 0);
+	parallel_for(quads_z, [&](const int p_row) {
+		const int32_t z = p_row;
+		int32_t count = 0;
+		for (int32_t x = 0; x < quads_x; x++) {
+			uint8_t mask = 0;
+			const float height1 = raw[gidx(x, z)];
+			if (height1 >= p_height_range.x && height1 <= p_height_range.y) {
+				const bool nan2 = std::isnan(raw[gidx(x + 1, z)]);
+				const bool nan3 = std::isnan(raw[gidx(x, z + 1)]);
+				const bool nan4 = std::isnan(raw[gidx(x + 1, z + 1)]);
+				const uint32_t ctrl1 = as_uint(controls[widx(x, z)]);
+				const uint32_t ctrl2 = as_uint(controls[widx(x + 1, z)]);
+				const uint32_t ctrl3 = as_uint(controls[widx(x, z + 1)]);
+				const uint32_t ctrl4 = as_uint(controls[widx(x + 1, z + 1)]);
+				const bool hole1 = ctrl1 != UINT32_MAX && is_hole(ctrl1);
+				const bool hole2 = ctrl2 != UINT32_MAX && is_hole(ctrl2);
+				const bool hole3 = ctrl3 != UINT32_MAX && is_hole(ctrl3);
+				const bool hole4 = ctrl4 != UINT32_MAX && is_hole(ctrl4);
+				const bool nav1 = ctrl1 != UINT32_MAX && is_nav(ctrl1);
+				const bool nav2 = ctrl2 != UINT32_MAX && is_nav(ctrl2) || nan2 && nav1;
+				const bool nav3 = ctrl3 != UINT32_MAX && is_nav(ctrl3) || nan3 && nav1;
+				const bool nav4 = ctrl4 != UINT32_MAX && is_nav(ctrl4) || nan4 && nav1;
+				if (!(hole1 || hole4 || hole3) && (!p_require_nav || (nav1 && nav4 && nav3))) {
+					mask |= 0x1;
+					count++;
+				}
+				if (!(hole1 || hole2 || hole4) && (!p_require_nav || (nav1 && nav2 && nav4))) {
+					mask |= 0x2;
+					count++;
+				}
+			}
+			tris[int64_t(z) * quads_x + x] = mask;
+		}
+		tri_rows[z + 1] = count;
+	});
+	auto tri_mask = [&](const int32_t p_x, const int32_t p_z) -> uint8_t {
+		if (p_x < 0 || p_z < 0 || p_x >= quads_x || p_z >= quads_z) {
+			return 0;
+		}
+		return tris[int64_t(p_z) * quads_x + p_x];
+	};
+
+	const int32_t verts_x = quads_x + 1;
+	const int32_t verts_z = quads_z + 1;
+	std::vector<int32_t> remap(int64_t(verts_x) * verts_z, -1);
+
+	// Optionally simplify, marking the vertices used by the adaptive triangles
+	std::vector<int32_t> adaptive;
+	const bool use_adaptive = p_max_error > 0.f && quads_x == quads_z && is_power_of_2(quads_x);
+	if (use_adaptive) {
+		std::vector<float> grid_heights(remap.size());
+		for (int32_t z = 0; z < verts_z; z++) {
+			for (int32_t x = 0; x < verts_x; x++) {
+				grid_heights[int64_t(z) * verts_x + x] = resolved[gidx(x, z)];
+			}
+		}
+		_triangulate_rtin(adaptive, quads_x, grid_heights, tris, p_max_error);
+		for (const int32_t id : adaptive) {
+			remap[id] = 0;
+		}
+	}
 
-	// Bake whole mesh, e.g. bake_mesh and painted navigation
-	if (!p_global_aabb.has_volume()) {
-		int32_t region_size = (int32_t)_region_size;
+	// Count the vertices used by any triangle, as vertex 1 or 4 of any, 2 of a top, or 3 of a bottom
+	std::vector<int32_t> vert_rows(verts_z + 1, 0);
+	parallel_for(verts_z, [&](const int p_row) {
+		const int32_t z = p_row;
+		int32_t count = 0;
+		for (int32_t x = 0; x < verts_x; x++) {
+			int32_t &id = remap[int64_t(z) * verts_x + x];
+			if (use_adaptive ? id >= 0 : (tri_mask(x, z) || tri_mask(x - 1, z - 1) || (tri_mask(x - 1, z) & 0x2) || (tri_mask(x, z - 1) & 0x1))) {
+				id = count++;
+			}
+		}
+		vert_rows[z + 1] = count;
+	});
+	for (int32_t z = 0; z < verts_z; z++) {
+		vert_rows[z + 1] += vert_rows[z];
+	}
+	for (int32_t z = 0; z < quads_z; z++) {
+		tri_rows[z + 1] += tri_rows[z];
+	}
+	const int64_t vertex_count = vert_rows[verts_z];
+	const int64_t tri_count = use_adaptive ? int64_t(adaptive.size() / 3) : tri_rows[quads_z];
+	if (tri_count == 0) {
+		return;
+	}
 
+	// Append vertices and attributes
+	const int64_t base_vertex = r_arrays.vertices.size();
+	const int64_t base_index = r_arrays.indices.size();
+	r_arrays.vertices.resize(base_vertex + vertex_count);
+	r_arrays.indices.resize(base_index + tri_count * 3);
+	if (p_attributes) {
+		r_arrays.normals.resize(base_vertex + vertex_count);
+		r_arrays.tangents.resize((base_vertex + vertex_count) * 4);
+		r_arrays.uvs.resize(base_vertex + vertex_count);
+	}
+	Vector3 *vertices = r_arrays.vertices.ptrw() + base_vertex;
+	Vector3 *normals = p_attributes ? r_arrays.normals.ptrw() + base_vertex : nullptr;
+	float *tangents = p_attributes ? r_arrays.tangents.ptrw() + base_vertex * 4 : nullptr;
+	Vector2 *uvs = p_attributes ? r_arrays.uvs.ptrw() + base_vertex : nullptr;
+	int32_t *indices = r_arrays.indices.ptrw() + base_index;
+	const real_t spacing = _vertex_spacing;
+
+	parallel_for(verts_z, [&](const int p_row) {
+		const int32_t z = p_row;
+		for (int32_t x = 0; x < verts_x; x++) {
+			int32_t &id = remap[int64_t(z) * verts_x + x];
+			if (id < 0) {
+				continue;
+			}
+			id += vert_rows[z];
+			const float height = resolved[gidx(x, z)];
+			const Vector3 pos = Vector3(real_t(p_area.position.x + x * step) * spacing, height,
+					real_t(p_area.position.y + z * step) * spacing);
+			vertices[id] = pos;
+			if (!p_attributes) {
+				continue;
+			}
+			// Central differences, or one sided where a neighbor is missing
+			auto slope = [&](const float p_prev, const float p_next) -> float {
+				const bool prev = !std::isnan(p_prev);
+				const bool next = !std::isnan(p_next);
+				const int32_t span = int32_t(prev) + int32_t(next);
+				return span ? ((next ? p_next : height) - (prev ? p_prev : height)) / (span * step * spacing) : 0.f;
+			};
+			const float dx = slope(resolved[gidx(x - 1, z)], resolved[gidx(x + 1, z)]);
+			const float dz = slope(resolved[gidx(x, z - 1)], resolved[gidx(x, z + 1)]);
+			normals[id] = Vector3(-dx, 1.f, -dz).normalized();
+			// Tangent follows +X, matching the uvs. It's already perpendicular to the normal
+			const Vector3 tangent = Vector3(1.f, dx, 0.f).normalized();
+			tangents[id * 4 + 0] = tangent.x;
+			tangents[id * 4 + 1] = tangent.y;
+			tangents[id * 4 + 2] = tangent.z;
+			tangents[id * 4 + 3] = 1.f;
+			uvs[id] = Vector2(pos.x, pos.z);
+		}
+	});
+
+	// Append indices, offset to the vertices already in r_arrays
+	if (use_adaptive) {
+		for (size_t i = 0; i < adaptive.size(); i++) {
+			indices[i] = int32_t(base_vertex) + remap[adaptive[i]];
+		}
+		return;
+	}
+	parallel_for(quads_z, [&](const int p_row) {
+		const int32_t z = p_row;
+		int32_t *idx = indices + int64_t(tri_rows[z]) * 3;
+		auto vid = [&](const int32_t p_x, const int32_t p_z) -> int32_t {
+			return int32_t(base_vertex) + remap[int64_t(p_z) * verts_x + p_x];
+		};
+		for (int32_t x = 0; x < quads_x; x++) {
+			const uint8_t mask = tris[int64_t(z) * quads_x + x];
+			if (mask & 0x1) {
+				*idx++ = vid(x, z);
+				*idx++ = vid(x + 1, z + 1);
+				*idx++ = vid(x, z + 1);
+			}
+			if (mask & 0x2) {
+				*idx++ = vid(x, z);
+				*idx++ = vid(x + 1, z);
+				*idx++ = vid(x + 1, z + 1);
+			}
+		}
+	});
+}
+
+/**
+ * Simplifies a square grid of p_size quads, a power of 2, with a right-triangulated irregular network.
+ * Based on the Martini algorithm: each vertex gets the largest interpolation error of the triangles it splits,
+ * then triangles are split from the two root halves down only where that error exceeds p_max_error. Since
+ * neighbors share the split vertex, the result has no cracks or T-junctions. The perimeter is kept at full
+ * resolution, so adjacent grids, eg. tiles or regions, share every edge vertex as well.
+ * p_heights: (p_size + 1)^2 vertex heights, in rows.
+ * p_tris: p_size^2 quad triangle masks from _generate_grid(). Quads missing either triangle, eg. holes, are
+ *  kept at full resolution and emit their own triangles.
+ * r_triangles: Appended with the vertex indices of clockwise triangles.
+ */
+void Terrain3D::_triangulate_rtin(std::vector<int32_t> &r_triangles, const int32_t p_size,
+		const std::vector<float> &p_heights, const std::vector<uint8_t> &p_tris, const real_t p_max_error) {
+	const int32_t grid = p_size + 1;
+	auto vidx = [grid](const int32_t p_x, const int32_t p_z) -> int32_t { return p_z * grid + p_x; };
+
+	// Force full resolution along the perimeter, so grids simplified separately meet without cracks
+	std::vector<float> errors(p_heights.size(), 0.f);
+	for (int32_t i = 0; i <= p_size; i++) {
+		errors[vidx(i, 0)] = FLT_MAX;
+		errors[vidx(i, p_size)] = FLT_MAX;
+		errors[vidx(0, i)] = FLT_MAX;
+		errors[vidx(p_size, i)] = FLT_MAX;
+	}
+
+	// And around partial quads
+	for (int32_t z = 0; z < p_size; z++) {
+		for (int32_t x = 0; x < p_size; x++) {
+			if (p_tris[z * p_size + x] != 0x3) {
+				errors[vidx(x, z)] = FLT_MAX;
+				errors[vidx(x + 1, z)] = FLT_MAX;
+				errors[vidx(x, z + 1)] = FLT_MAX;
+				errors[vidx(x + 1, z + 1)] = FLT_MAX;
+			}
+		}
+	}
+
+	// Accumulate errors from the smallest triangles up, so each vertex includes those of its descendants
+	const int64_t tri_count = int64_t(p_size) * p_size * 2 - 2;
+	const int64_t parent_count = tri_count - int64_t(p_size) * p_size;
+	for (int64_t i = tri_count - 1; i >= 0; i--) {
+		// Walk the triangle's id down from the root to find its hypotenuse a-b and right angle c
+		int64_t id = i + 2;
+		int32_t ax = 0, az = 0, bx = 0, bz = 0, cx = 0, cz = 0;
+		// Roots match the emission roots below: a(0,0) b(S,S) c(S,0), and a(S,S) b(0,0) c(0,S)
+		if (id & 1) {
+			bx = bz = cx = p_size; // x > z root
+		} else {
+			ax = az = cz = p_size; // x < z root
+		}
+		while ((id >>= 1) > 1) {
+			const int32_t mx = (ax + bx) >> 1;
+			const int32_t mz = (az + bz) >> 1;
+			if (id & 1) { // Left child
+				bx = ax;
+				bz = az;
+				ax = cx;
+				az = cz;
+			} else { // Right child
+				ax = bx;
+				az = bz;
+				bx = cx;
+				bz = cz;
+			}
+			cx = mx;
+			cz = mz;
+		}
+		const int32_t mx = (ax + bx) >> 1;
+		const int32_t mz = (az + bz) >> 1;
+		const int32_t m = vidx(mx, mz);
+		const float ha = p_heights[vidx(ax, az)];
+		const float hb = p_heights[vidx(bx, bz)];
+		const float hm = p_heights[m];
+		float error = std::abs((ha + hb) * 0.5f - hm);
+		if (std::isnan(error)) {
+			error = FLT_MAX;
+		}
+		errors[m] = MAX(errors[m], error);
+		if (i < parent_count) {
+			const int32_t rx = mx + mz - az;
+			const int32_t rz = mz + ax - mx;
+			errors[m] = MAX(errors[m], errors[vidx((ax + rx) >> 1, (az + rz) >> 1)]);
+			errors[m] = MAX(errors[m], errors[vidx((bx + rx) >> 1, (bz + rz) >> 1)]);
+		}
+	}
+
+	// Split the two roots as needed, emitting clockwise triangles
+	struct Tri {
+		int32_t ax, az, bx, bz, cx, cz;
+	};
+	std::vector<Tri> stack = { { 0, 0, p_size, p_size, p_size, 0 }, { p_size, p_size, 0, 0, 0, p_size } };
+	std::vector<uint8_t> partial_done(p_tris.size(), 0);
+	while (!stack.empty()) {
+		const Tri t = stack.back();
+		stack.pop_back();
+		const int32_t mx = (t.ax + t.bx) >> 1;
+		const int32_t mz = (t.az + t.bz) >> 1;
+		const bool leaf = std::abs(t.ax - t.cx) + std::abs(t.az - t.cz) <= 1;
+		if (!leaf && errors[vidx(mx, mz)] > p_max_error) {
+			stack.push_back({ t.cx, t.cz, t.ax, t.az, mx, mz });
+			stack.push_back({ t.bx, t.bz, t.cx, t.cz, mx, mz });
+			continue;
+		}
+		if (leaf) {
+			// Partial quads emit their own triangles, 143 and 124 as in _generate_grid()
+			const int32_t qx = MIN(MIN(t.ax, t.bx), t.cx);
+			const int32_t qz = MIN(MIN(t.az, t.bz), t.cz);
+			const int32_t q = qz * p_size + qx;
+			const uint8_t mask = p_tris[q];
+			if (mask != 0x3) {
+				if (!partial_done[q]) {
+					partial_done[q] = 1;
+					if (mask & 0x1) {
+						r_triangles.insert(r_triangles.end(), { vidx(qx, qz), vidx(qx + 1, qz + 1), vidx(qx, qz + 1) });
+					}
+					if (mask & 0x2) {
+						r_triangles.insert(r_triangles.end(), { vidx(qx, qz), vidx(qx + 1, qz), vidx(qx + 1, qz + 1) });
+					}
+				}
+				continue;
+			}
+		}
+		r_triangles.insert(r_triangles.end(), { vidx(t.ax, t.az), vidx(t.cx, t.cz), vidx(t.bx, t.bz) });
+	}
+}
+
+// Builds navigation geometry for generate_nav_mesh_source_geometry() and generate_nav_mesh_source_arrays().
+// An AABB is built as quads whose upper left vertex is within it, or when simplifying, as the triangles
+// touching it. The whole terrain, simplified geometry, and anything with navigation_cache are built in
+// tiles by _generate_nav_arrays_tiled(), so all paths return the same geometry.
+void Terrain3D::_generate_nav_arrays(MeshArrays &r_arrays, const AABB &p_global_aabb, const bool p_require_nav,
+		const real_t p_max_error) const {
+	ERR_FAIL_COND(_data == nullptr);
+	if (_navigation_cache || !p_global_aabb.has_volume() || p_max_error > 0.f) {
+		_generate_nav_arrays_tiled(r_arrays, p_global_aabb, p_require_nav, p_max_error);
+		return;
+	}
+	const Terrain3DData::HeightFilter filter = Terrain3DData::HEIGHT_FILTER_NEAREST;
+
+	// Quads whose upper left vertex is within the AABB, built in tiles. Tiles without regions, or with all
+	// heights outside the AABB height range, are skipped using the region height bounds, without reading maps.
+	const Vector3 start = (p_global_aabb.position / _vertex_spacing).ceil();
+	const Vector3 end = (p_global_aabb.get_end() / _vertex_spacing).floor() + V3(1.f);
+	const Rect2i area = Rect2i(int32_t(start.x), int32_t(start.z), int32_t(end.x - start.x), int32_t(end.z - start.z));
+	if (!area.has_area()) {
+		return;
+	}
+	const Vector2 height_range = Vector2(p_global_aabb.position.y, p_global_aabb.get_end().y);
+	const Vector2i area_end = area.get_end();
+	const Vector2i tile_start = V2I_DIVIDE_FLOOR(area.position, NAV_TILE_SIZE);
+	const Vector2i tile_end = V2I_DIVIDE_CEIL(area_end, NAV_TILE_SIZE);
+	std::vector<Rect2i> tiles;
+	for (int32_t y = tile_start.y; y < tile_end.y; y++) {
+		for (int32_t x = tile_start.x; x < tile_end.x; x++) {
+			const Rect2i tile = area.intersection(Rect2i(Vector2i(x, y) * NAV_TILE_SIZE, V2I(NAV_TILE_SIZE)));
+			const Vector2 bounds = _data->get_height_bounds(tile);
+			if (std::isnan(bounds.x) || bounds.y < height_range.x || bounds.x > height_range.y) {
+				continue;
+			}
+			tiles.push_back(tile);
+		}
+	}
+	LOG(DEBUG, "Navigation AABB spans ", (tile_end - tile_start).x * (tile_end - tile_start).y, " tiles, building ", int(tiles.size()));
+
+	std::vector<MeshArrays> tile_arrays(tiles.size());
+	parallel_for(int(tiles.size()), [&](const int p_index) {
+		_generate_grid(tile_arrays[p_index], tiles[p_index], 0, filter, p_require_nav, false, 0.f, height_range);
+	});
+	for (const MeshArrays &arrays : tile_arrays) {
+		const int32_t base_vertex = r_arrays.vertices.size();
+		r_arrays.vertices.append_array(arrays.vertices);
+		const int64_t count = r_arrays.indices.size();
+		r_arrays.indices.resize(count + arrays.indices.size());
+		const int32_t *src = arrays.indices.ptr();
+		int32_t *dst = r_arrays.indices.ptrw() + count;
+		for (int64_t i = 0; i < arrays.indices.size(); i++) {
+			dst[i] = base_vertex + src[i];
+		}
+	}
+}
+
+// Builds navigation geometry in tiles of NAV_TILE_SIZE vertices, reading those that are cached with
+// navigation_cache and regenerating only tiles that are missing or were edited. Tiles touching the AABB
+// are used, or all tiles if it's empty. Then quads whose upper left vertex is within the AABB are kept, as
+// _generate_nav_arrays() does, or when simplifying, triangles touching it.
+void Terrain3D::_generate_nav_arrays_tiled(MeshArrays &r_arrays, const AABB &p_global_aabb, const bool p_require_nav,
+		const real_t p_max_error) const {
+	const bool use_aabb = p_global_aabb.has_volume();
+	const bool use_cache = _navigation_cache;
+	std::vector<Vector2i> tiles;
+	if (use_aabb) {
+		Vector2i start = V2I_DIVIDE_FLOOR(v3v2i((p_global_aabb.position / _vertex_spacing).floor()), NAV_TILE_SIZE);
+		Vector2i end = V2I_DIVIDE_FLOOR(v3v2i((p_global_aabb.get_end() / _vertex_spacing).floor()), NAV_TILE_SIZE);
+		for (int32_t y = start.y; y <= end.y; y++) {
+			for (int32_t x = start.x; x <= end.x; x++) {
+				Vector2i tile = Vector2i(x, y);
+				Vector2i tile_pos = tile * NAV_TILE_SIZE;
+				if (!_data->has_region(V2I_DIVIDE_FLOOR(tile_pos, _region_size))) {
+					continue;
+				}
+				// Skip tiles entirely above or below the AABB, including the edge vertices shared with neighbors
+				const Vector2 bounds = _data->get_height_bounds(Rect2i(tile_pos, V2I(NAV_TILE_SIZE)).grow(1));
+				if (bounds.y < p_global_aabb.position.y || bounds.x > p_global_aabb.get_end().y) {
+					continue;
+				}
+				tiles.push_back(tile);
+			}
+		}
+	} else {
+		const int32_t tiles_per_region = MAX(1, _region_size / NAV_TILE_SIZE);
 		TypedArray<Vector2i> region_locations = _data->get_region_locations();
 		for (const Vector2i &region_loc : region_locations) {
-			Vector2i region_pos = region_loc * region_size;
-			for (int32_t z = region_pos.y; z < region_pos.y + region_size; z += step) {
-				for (int32_t x = region_pos.x; x < region_pos.x + region_size; x += step) {
-					_generate_triangle_pair(p_vertices, p_uvs, p_lod, p_filter, p_require_nav, x, z);
+			for (int32_t y = 0; y < tiles_per_region; y++) {
+				for (int32_t x = 0; x < tiles_per_region; x++) {
+					tiles.push_back(region_loc * tiles_per_region + Vector2i(x, y));
 				}
 			}
 		}
+	}
+
+	// Gather cached tiles and note the versions of those to build
+	std::vector<MeshArrays> tile_arrays(tiles.size());
+	std::vector<size_t> to_build;
+	std::vector<std::pair<uint64_t, uint32_t>> build_versions;
+	if (!use_cache) {
+		to_build.resize(tiles.size());
+		for (size_t i = 0; i < tiles.size(); i++) {
+			to_build[i] = i;
+		}
 	} else {
-		// Bake within an AABB, e.g. runtime navigation baker
-		int32_t z_start = (int32_t)Math::ceil(p_global_aabb.position.z / _vertex_spacing);
-		int32_t z_end = (int32_t)Math::floor(p_global_aabb.get_end().z / _vertex_spacing) + 1;
-		int32_t x_start = (int32_t)Math::ceil(p_global_aabb.position.x / _vertex_spacing);
-		int32_t x_end = (int32_t)Math::floor(p_global_aabb.get_end().x / _vertex_spacing) + 1;
-
-		for (int32_t z = z_start; z < z_end; ++z) {
-			for (int32_t x = x_start; x < x_end; ++x) {
-				real_t height = _data->get_height(Vector3(x, 0.f, z));
-				if (height >= p_global_aabb.position.y && height <= p_global_aabb.get_end().y) {
-					_generate_triangle_pair(p_vertices, p_uvs, p_lod, p_filter, p_require_nav, x, z);
+		std::lock_guard<std::mutex> lock(_nav_cache_mutex);
+		if (p_require_nav != _nav_cache_require_nav || p_max_error != _nav_cache_max_error) {
+			_nav_cache.clear();
+			_nav_cache_epoch++;
+			_nav_cache_require_nav = p_require_nav;
+			_nav_cache_max_error = p_max_error;
+		}
+		for (size_t i = 0; i < tiles.size(); i++) {
+			const auto version_it = _nav_versions.find(tiles[i]);
+			const uint32_t version = (version_it != _nav_versions.end()) ? version_it->second : 0;
+			auto it = _nav_cache.find(tiles[i]);
+			if (it != _nav_cache.end() && it->second.epoch == _nav_cache_epoch && it->second.version == version) {
+				tile_arrays[i] = it->second.arrays;
+			} else {
+				to_build.push_back(i);
+				build_versions.push_back({ _nav_cache_epoch, version });
+			}
+		}
+	}
+	if (use_cache) {
+		LOG(DEBUG, "Navigation cache: ", int(tiles.size() - to_build.size()), " tiles cached, ", int(to_build.size()), " to build");
+	}
+
+	parallel_for(int(to_build.size()), [&](const int p_index) {
+		const Vector2i &tile = tiles[to_build[p_index]];
+		_generate_grid(tile_arrays[to_build[p_index]], Rect2i(tile * NAV_TILE_SIZE, V2I(NAV_TILE_SIZE)), 0,
+				Terrain3DData::HEIGHT_FILTER_NEAREST, p_require_nav, false, p_max_error);
+	});
+
+	// Keep built tiles unless an edit landed meanwhile
+	if (use_cache) {
+		std::lock_guard<std::mutex> lock(_nav_cache_mutex);
+		for (size_t b = 0; b < to_build.size(); b++) {
+			const Vector2i &tile = tiles[to_build[b]];
+			const auto version_it = _nav_versions.find(tile);
+			const uint32_t version = (version_it != _nav_versions.end()) ? version_it->second : 0;
+			if (build_versions[b].first == _nav_cache_epoch && build_versions[b].second == version) {
+				_nav_cache[tile] = { build_versions[b].first, build_versions[b].second, tile_arrays[to_build[b]] };
+			}
+		}
+	}
+
+	// Concatenate, keeping quads or triangles within the AABB. Both triangles of a quad share its upper
+	// left vertex, which has the lowest x + z.
+	const bool by_quad = use_aabb && p_max_error <= 0.f;
+	const Vector3 quad_start = (p_global_aabb.position / _vertex_spacing).ceil();
+	const Vector3 quad_end = (p_global_aabb.get_end() / _vertex_spacing).floor();
+	for (const MeshArrays &arrays : tile_arrays) {
+		const int32_t base_vertex = r_arrays.vertices.size();
+		r_arrays.vertices.append_array(arrays.vertices);
+		const Vector3 *vertices = arrays.vertices.ptr();
+		const int32_t *indices = arrays.indices.ptr();
+		const int64_t index_count = arrays.indices.size();
+		int64_t count = r_arrays.indices.size();
+		r_arrays.indices.resize(count + index_count);
+		int32_t *dst = r_arrays.indices.ptrw();
+		for (int64_t i = 0; i < index_count; i += 3) {
+			if (by_quad) {
+				const Vector3 &v1 = vertices[indices[i]];
+				const Vector3 &v2 = vertices[indices[i + 1]];
+				const Vector3 &v3 = vertices[indices[i + 2]];
+				const real_t s1 = v1.x + v1.z;
+				const real_t s2 = v2.x + v2.z;
+				const real_t s3 = v3.x + v3.z;
+				const Vector3 &upper_left = (s1 <= s2 && s1 <= s3) ? v1 : ((s2 <= s3) ? v2 : v3);
+				const Vector3 pos = (upper_left / _vertex_spacing).round();
+				if (pos.x < quad_start.x || pos.x > quad_end.x || pos.z < quad_start.z || pos.z > quad_end.z ||
+						upper_left.y < p_global_aabb.position.y || upper_left.y > p_global_aabb.get_end().y) {
+					continue;
+				}
+			} else if (use_aabb) {
+				AABB tri_aabb = AABB(vertices[indices[i]], V3_ZERO).expand(vertices[indices[i + 1]]).expand(vertices[indices[i + 2]]);
+				if (!tri_aabb.intersects_inclusive(p_global_aabb)) {
+					continue;
 				}
 			}
+			dst[count++] = base_vertex + indices[i];
+			dst[count++] = base_vertex + indices[i + 1];
+			dst[count++] = base_vertex + indices[i + 2];
 		}
+		r_arrays.indices.resize(count);
 	}
 }
 
-// Generates two triangles: Top 124, Bottom 143
-//		1  __  2
-//		  |\ |
-//		  | \|
-//		3  --  4
-// p_vertices is assumed to exist and the destination for data
-// p_uvs might not exist, so a pointer is fine
-// p_require_nav is false for the runtime baker, which ignores navigation
-void Terrain3D::_generate_triangle_pair(PackedVector3Array &p_vertices, PackedVector2Array *p_uvs,
-		const int32_t p_lod, const Terrain3DData::HeightFilter p_filter, const bool p_require_nav,
-		const int32_t x, const int32_t z) const {
-	int32_t step = 1 << CLAMP(p_lod, 0, 8);
-	Vector3 xz = Vector3(x, 0.0f, z) * _vertex_spacing;
-	Vector3 xsz = Vector3(x + step, 0.0f, z) * _vertex_spacing;
-	Vector3 xzs = Vector3(x, 0.0f, z + step) * _vertex_spacing;
-	Vector3 xszs = Vector3(x + step, 0.0f, z + step) * _vertex_spacing;
-	Vector3 v1 = _data->get_mesh_vertex(p_lod, p_filter, xz);
-	bool nan1 = std::isnan(v1.y);
-	if (nan1) {
+// Connected to Terrain3DData::maps_edited. Bumps the version of tiles touching the area, including the
+// neighbors sharing its border vertices.
+void Terrain3D::_invalidate_nav_cache(const AABB &p_global_aabb) {
+	if (!_navigation_cache) {
 		return;
 	}
-	Vector3 v2 = _data->get_mesh_vertex(p_lod, p_filter, xsz);
-	Vector3 v3 = _data->get_mesh_vertex(p_lod, p_filter, xzs);
-	Vector3 v4 = _data->get_mesh_vertex(p_lod, p_filter, xszs);
-	bool nan2 = std::isnan(v2.y);
-	bool nan3 = std::isnan(v3.y);
-	bool nan4 = std::isnan(v4.y);
-	// If on the region edge, duplicate the edge pixels
-	// Check #2 upper right
-	if (nan2) {
-		v2.y = v1.y;
-	}
-	// Check #3 lower left
-	if (nan3) {
-		v3.y = v1.y;
-	}
-	// Check #4 lower right
-	if (nan4) {
-		if (!nan2) {
-			v4.y = v2.y;
-		} else if (!nan3) {
-			v4.y = v3.y;
+	std::lock_guard<std::mutex> lock(_nav_cache_mutex);
+	Vector2i start_pos = v3v2i((p_global_aabb.position / _vertex_spacing).floor()) - V2I(1);
+	Vector2i start = V2I_DIVIDE_FLOOR(start_pos, NAV_TILE_SIZE);
+	Vector2i end = V2I_DIVIDE_FLOOR(v3v2i((p_global_aabb.get_end() / _vertex_spacing).ceil()), NAV_TILE_SIZE);
+	for (int32_t y = start.y; y <= end.y; y++) {
+		for (int32_t x = start.x; x <= end.x; x++) {
+			Vector2i tile = Vector2i(x, y);
+			_nav_versions[tile]++;
+			_nav_cache.erase(tile);
+		}
+	}
+	LOG(DEBUG, "Invalidated navigation cache tiles from ", start, " to ", end);
+}
+
+// Appends a skirt hanging p_depth below the border of a tile built by _generate_grid() for p_area, which
+// hides cracks against neighboring tiles baked at another lod. r_arrays must contain only that tile.
+void Terrain3D::_generate_skirt(MeshArrays &r_arrays, const Rect2i &p_area, const int32_t p_lod, const real_t p_depth) const {
+	if (p_depth <= 0.f || r_arrays.vertices.is_empty()) {
+		return;
+	}
+	const int32_t step = 1 << CLAMP(p_lod, 0, 8);
+	const real_t spacing = _vertex_spacing;
+	const int32_t quads_x = (p_area.size.x + step - 1) / step;
+	const int32_t quads_z = (p_area.size.y + step - 1) / step;
+	const real_t min_x = p_area.position.x * spacing;
+	const real_t min_z = p_area.position.y * spacing;
+	const real_t max_x = (p_area.position.x + quads_x * step) * spacing;
+	const real_t max_z = (p_area.position.y + quads_z * step) * spacing;
+
+	// Border vertex ids indexed by position along each edge: left, right, top, bottom
+	std::vector<int32_t> edges[4] = {
+		std::vector<int32_t>(quads_z + 1, -1), std::vector<int32_t>(quads_z + 1, -1),
+		std::vector<int32_t>(quads_x + 1, -1), std::vector<int32_t>(quads_x + 1, -1)
+	};
+	const Vector3 *vertices = r_arrays.vertices.ptr();
+	const int32_t vertex_count = r_arrays.vertices.size();
+	for (int32_t i = 0; i < vertex_count; i++) {
+		const Vector3 &v = vertices[i];
+		const int32_t x = int32_t(Math::round((v.x - min_x) / (step * spacing)));
+		const int32_t z = int32_t(Math::round((v.z - min_z) / (step * spacing)));
+		if (Math::is_equal_approx(v.x, min_x)) {
+			edges[0][z] = i;
+		} else if (Math::is_equal_approx(v.x, max_x)) {
+			edges[1][z] = i;
+		}
+		if (Math::is_equal_approx(v.z, min_z)) {
+			edges[2][x] = i;
+		} else if (Math::is_equal_approx(v.z, max_z)) {
+			edges[3][x] = i;
+		}
+	}
+
+	const bool attributes = r_arrays.normals.size() == vertex_count;
+	auto add_vertex = [&](const int32_t p_id) -> int32_t {
+		// Copy before pushing, as pushing may reallocate
+		const Vector3 vertex = r_arrays.vertices[p_id] - Vector3(0.f, p_depth, 0.f);
+		r_arrays.vertices.push_back(vertex);
+		if (attributes) {
+			const Vector3 normal = r_arrays.normals[p_id];
+			const Vector2 uv = r_arrays.uvs[p_id];
+			r_arrays.normals.push_back(normal);
+			for (int j = 0; j < 4; j++) {
+				const float tangent = r_arrays.tangents[p_id * 4 + j];
+				r_arrays.tangents.push_back(tangent);
+			}
+			r_arrays.uvs.push_back(uv);
+		}
+		return r_arrays.vertices.size() - 1;
+	};
+	// Clockwise facing outwards. Left and bottom edges run with the screen, right and top against it
+	for (int e = 0; e < 4; e++) {
+		const bool forward = (e == 0 || e == 3);
+		const std::vector<int32_t> &edge = edges[e];
+		for (size_t i = 0; i + 1 < edge.size(); i++) {
+			int32_t a = edge[i];
+			int32_t b = edge[i + 1];
+			if (a < 0 || b < 0) {
+				continue;
+			}
+			if (!forward) {
+				SWAP(a, b);
+			}
+			const int32_t a_low = add_vertex(a);
+			const int32_t b_low = add_vertex(b);
+			const int32_t quad[6] = { a, b, b_low, a, b_low, a_low };
+			for (const int32_t id : quad) {
+				r_arrays.indices.push_back(id);
+			}
+		}
+	}
+}
+
+/**
+ * Generates a conservative occluder for one region: a uniform grid at the finest step that fits within
+ * _occlusion_triangle_budget. Each vertex takes the minimum height of all quads that touch it, read from
+ * the pyramid level with one block per quad, so every triangle lies at or below the terrain it covers, and
+ * below the clipmap at any LOD. Triangles touching holes are left out.
+ */
+void Terrain3D::_generate_occluder_arrays(MeshArrays &r_arrays, const Vector2i &p_region_loc) const {
+	const int32_t region_size = _data->get_region_size();
+	int32_t step = 1;
+	int32_t level = 0;
+	while (step < region_size && 2 * (region_size / step) * (region_size / step) > _occlusion_triangle_budget) {
+		step *= 2;
+		level++;
+	}
+	const int32_t quads = region_size / step;
+	const int32_t verts = quads + 1;
+	const Rect2i region_rect = Rect2i(p_region_loc * region_size, V2I(region_size));
+
+	// Quads of this region plus the first row and column of the next regions, which the last quads
+	// interpolate towards
+	const int32_t blocks_size = quads + 1;
+	std::vector<float> mins(int64_t(blocks_size) * blocks_size);
+	_data->read_min_height_rect(level, Rect2i(region_rect.position / step, V2I(blocks_size)), mins.data());
+	auto min_height = [&](const int32_t p_x, const int32_t p_z, const int32_t p_last) -> float {
+		float height = FLT_MAX;
+		for (int32_t z = MAX(p_z - 1, 0); z <= MIN(p_z, p_last); z++) {
+			for (int32_t x = MAX(p_x - 1, 0); x <= MIN(p_x, p_last); x++) {
+				const float h = mins[int64_t(z) * blocks_size + x];
+				if (std::isnan(h)) {
+					return NAN;
+				}
+				height = MIN(height, h);
+			}
+		}
+		return height;
+	};
+
+	std::vector<int32_t> remap(int64_t(verts) * verts, -1);
+	for (int32_t z = 0; z < verts; z++) {
+		for (int32_t x = 0; x < verts; x++) {
+			const Vector2i pos = region_rect.position + Vector2i(x, z) * step;
+			real_t height = min_height(x, z, quads);
+			if (std::isnan(height)) {
+				// Neighbors may be missing, so retry within this region. Holes are still NAN
+				height = min_height(x, z, quads - 1);
+			}
+			if (std::isnan(height)) {
+				continue;
+			}
+			remap[int64_t(z) * verts + x] = int32_t(r_arrays.vertices.size());
+			r_arrays.vertices.push_back(Vector3(real_t(pos.x), height, real_t(pos.y)) * Vector3(_vertex_spacing, 1.f, _vertex_spacing));
+		}
+	}
+	auto vid = [&](const int32_t p_x, const int32_t p_z) -> int32_t {
+		return remap[int64_t(p_z) * verts + p_x];
+	};
+	for (int32_t z = 0; z < quads; z++) {
+		for (int32_t x = 0; x < quads; x++) {
+			const int32_t v1 = vid(x, z);
+			const int32_t v2 = vid(x + 1, z);
+			const int32_t v3 = vid(x, z + 1);
+			const int32_t v4 = vid(x + 1, z + 1);
+			if (v1 >= 0 && v4 >= 0 && v3 >= 0) {
+				r_arrays.indices.push_back(v1);
+				r_arrays.indices.push_back(v4);
+				r_arrays.indices.push_back(v3);
+			}
+			if (v1 >= 0 && v2 >= 0 && v4 >= 0) {
+				r_arrays.indices.push_back(v1);
+				r_arrays.indices.push_back(v2);
+				r_arrays.indices.push_back(v4);
+			}
+		}
+	}
+}
+
+void Terrain3D::_mark_occluders_dirty() {
+	if (!_data) {
+		return;
+	}
+	LOG(EXTREME, "Marking all occluders dirty");
+	for (const Vector2i &region_loc : _data->get_region_locations()) {
+		_dirty_occluders.insert(region_loc);
+	}
+	_occluders_dirty = true;
+}
+
+// Marks occluders of regions overlapping the edited area for rebuilding
+void Terrain3D::_invalidate_occluders(const AABB &p_global_aabb) {
+	if (!_occlusion_enabled || !_data) {
+		return;
+	}
+	// Edge vertices also read the first pixels of the next regions
+	const Vector2i start_loc = _data->get_region_location(p_global_aabb.position - Vector3(_vertex_spacing, 0.f, _vertex_spacing));
+	const Vector2i end_loc = _data->get_region_location(p_global_aabb.get_end());
+	for (int32_t z = start_loc.y; z <= end_loc.y; z++) {
+		for (int32_t x = start_loc.x; x <= end_loc.x; x++) {
+			if (_data->has_region(Vector2i(x, z))) {
+				_dirty_occluders.insert(Vector2i(x, z));
+			}
+		}
+	}
+	_occluders_dirty = true;
+}
+
+// Frees occluders of removed regions and rebuilds those marked dirty, generating in parallel
+void Terrain3D::_update_occluders() {
+	_occluders_dirty = false;
+	if (!_data || !is_inside_world()) {
+		return;
+	}
+	const TypedArray<Vector2i> region_locations = _data->get_region_locations();
+	std::unordered_set<Vector2i, Vector2iHash> active;
+	for (const Vector2i &region_loc : region_locations) {
+		active.insert(region_loc);
+	}
+	for (auto it = _occluders.begin(); it != _occluders.end();) {
+		if (active.count(it->first) == 0) {
+			LOG(DEBUG, "Freeing occluder for removed region ", it->first);
+			RS->free_rid(it->second.instance);
+			RS->free_rid(it->second.occluder);
+			it = _occluders.erase(it);
 		} else {
-			v4.y = v1.y;
-		}
-	}
-	uint32_t ctrl1 = _data->get_control(xz);
-	uint32_t ctrl2 = _data->get_control(xsz);
-	uint32_t ctrl3 = _data->get_control(xzs);
-	uint32_t ctrl4 = _data->get_control(xszs);
-	// Holes are only where the control map is valid and the bit is set
-	bool hole1 = ctrl1 != UINT32_MAX && is_hole(ctrl1);
-	bool hole2 = ctrl2 != UINT32_MAX && is_hole(ctrl2);
-	bool hole3 = ctrl3 != UINT32_MAX && is_hole(ctrl3);
-	bool hole4 = ctrl4 != UINT32_MAX && is_hole(ctrl4);
-	// Navigation is where the control map is valid and the bit is set, or it's the region edge and nav1 is set
-	bool nav1 = ctrl1 != UINT32_MAX && is_nav(ctrl1);
-	bool nav2 = ctrl2 != UINT32_MAX && is_nav(ctrl2) || nan2 && nav1;
-	bool nav3 = ctrl3 != UINT32_MAX && is_nav(ctrl3) || nan3 && nav1;
-	bool nav4 = ctrl4 != UINT32_MAX && is_nav(ctrl4) || nan4 && nav1;
-	//Bottom 143 triangle
-	if (!(hole1 || hole4 || hole3) && (!p_require_nav || (nav1 && nav4 && nav3))) {
-		p_vertices.push_back(v1);
-		p_vertices.push_back(v4);
-		p_vertices.push_back(v3);
-		if (p_uvs) {
-			p_uvs->push_back(Vector2(v1.x, v1.z));
-			p_uvs->push_back(Vector2(v4.x, v4.z));
-			p_uvs->push_back(Vector2(v3.x, v3.z));
-		}
-	}
-	// Top 124 triangle
-	if (!(hole1 || hole2 || hole4) && (!p_require_nav || (nav1 && nav2 && nav4))) {
-		p_vertices.push_back(v1);
-		p_vertices.push_back(v2);
-		p_vertices.push_back(v4);
-		if (p_uvs) {
-			p_uvs->push_back(Vector2(v1.x, v1.z));
-			p_uvs->push_back(Vector2(v2.x, v2.z));
-			p_uvs->push_back(Vector2(v4.x, v4.z));
+			++it;
+		}
+	}
+
+	std::vector<Vector2i> locations;
+	for (const Vector2i &region_loc : _dirty_occluders) {
+		if (active.count(region_loc) > 0) {
+			locations.push_back(region_loc);
 		}
 	}
+	_dirty_occluders.clear();
+	if (locations.empty()) {
+		return;
+	}
+	LOG(DEBUG, "Rebuilding ", locations.size(), " region occluders");
+	std::vector<MeshArrays> arrays(locations.size());
+	parallel_for(int(locations.size()), [&](const int p_index) {
+		_generate_occluder_arrays(arrays[p_index], locations[p_index]);
+	});
+
+	const RID scenario = get_world_3d()->get_scenario();
+	const bool visible = is_visible_in_tree();
+	for (size_t i = 0; i < locations.size(); i++) {
+		auto it = _occluders.find(locations[i]);
+		if (it == _occluders.end()) {
+			RegionOccluder occluder;
+			occluder.occluder = RS->occluder_create();
+			occluder.instance = RS->instance_create2(occluder.occluder, scenario);
+			it = _occluders.emplace(locations[i], occluder).first;
+		}
+		RS->occluder_set_mesh(it->second.occluder, arrays[i].vertices, arrays[i].indices);
+		RS->instance_set_visible(it->second.instance, visible);
+	}
+}
+
+void Terrain3D::_destroy_occluders() {
+	LOG(INFO, "Destroying occluders");
+	for (const std::pair<const Vector2i, RegionOccluder> &entry : _occluders) {
+		RS->free_rid(entry.second.instance);
+		RS->free_rid(entry.second.occluder);
+	}
+	_occluders.clear();
+	_dirty_occluders.clear();
+	_occluders_dirty = false;
 }
 
 ///////////////////////////
@@ -529,6 +1618,7 @@ void Terrain3D::set_data_directory(String p_dir) {
 		_initialized = false;
 		_destroy_labels();
 		_destroy_collision();
+		_destroy_navigation();
 		_destroy_instancer();
 		memdelete_safely(_data);
 		_initialize();
@@ -642,7 +1732,7 @@ void Terrain3D::set_camera(Camera3D *p_camera) {
 		LOG(EXTREME, "Setting camera: ", p_camera);
 		_camera.set_target(p_camera);
 		if (_clipmap_target.is_valid()) {
-			set_physics_process(true);
+			_set_processing(true);
 		}
 	}
 }
@@ -652,7 +1742,7 @@ void Terrain3D::set_clipmap_target(Node3D *p_node) {
 		LOG(INFO, "Setting clipmap target: ", p_node);
 		_clipmap_target.set_target(p_node);
 		if (_clipmap_target.is_valid()) {
-			set_physics_process(true);
+			_set_processing(true);
 		}
 	}
 }
@@ -670,12 +1760,64 @@ Vector3 Terrain3D::get_clipmap_target_position() const {
 	return V3_ZERO;
 }
 
+// Adds a clipmap ring that follows p_target and is drawn only on p_render_layers, or updates the
+// layers of an existing one. Viewpoint cameras should cull the main terrain render layers.
+void Terrain3D::add_clipmap_viewpoint(Node3D *p_target, const uint32_t p_render_layers) {
+	if (!p_target) {
+		LOG(ERROR, "Clipmap viewpoint target is null");
+		return;
+	}
+	Terrain3DMesher *mesher = nullptr;
+	for (Terrain3DMesher *m : _viewpoint_meshers) {
+		if (m->get_viewpoint_target() == p_target) {
+			mesher = m;
+			break;
+		}
+	}
+	if (mesher) {
+		LOG(INFO, "Setting clipmap viewpoint ", p_target, " render layers to: ", p_render_layers);
+		mesher->set_render_layers(p_render_layers);
+		mesher->update();
+		return;
+	}
+	LOG(INFO, "Adding clipmap viewpoint: ", p_target, " on render layers: ", p_render_layers);
+	mesher = new Terrain3DMesher();
+	mesher->set_viewpoint_target(p_target);
+	mesher->set_render_layers(p_render_layers);
+	_viewpoint_meshers.push_back(mesher);
+	if (_terrain_mesher) {
+		mesher->initialize_viewpoint(_terrain_mesher);
+	}
+}
+
+void Terrain3D::remove_clipmap_viewpoint(Node3D *p_target) {
+	for (int i = 0; i < int(_viewpoint_meshers.size()); i++) {
+		if (_viewpoint_meshers[i]->get_viewpoint_target() == p_target) {
+			LOG(INFO, "Removing clipmap viewpoint: ", p_target);
+			delete _viewpoint_meshers[i];
+			_viewpoint_meshers.erase(_viewpoint_meshers.begin() + i);
+			return;
+		}
+	}
+	LOG(WARN, "Clipmap viewpoint not found: ", p_target);
+}
+
+TypedArray<Node3D> Terrain3D::get_clipmap_viewpoints() const {
+	TypedArray<Node3D> targets;
+	for (const Terrain3DMesher *mesher : _viewpoint_meshers) {
+		if (Node3D *target = mesher->get_viewpoint_target()) {
+			targets.push_back(target);
+		}
+	}
+	return targets;
+}
+
 void Terrain3D::set_collision_target(Node3D *p_node) {
 	if (_collision_target.ptr() != p_node) {
 		LOG(INFO, "Setting collision target: ", p_node);
 		_collision_target.set_target(p_node);
 		if (_collision_target.is_valid()) {
-			set_physics_process(true);
+			_set_processing(true);
 		}
 	}
 }
@@ -704,15 +1846,63 @@ void Terrain3D::set_light_target(Node3D *p_node) {
 		LOG(INFO, "Setting directional light target: ", p_node);
 		_light_target.set_target(p_node);
 		if (_light_target.is_valid()) {
-			set_physics_process(true);
+			_set_processing(true);
+		}
+	}
+}
+
+void Terrain3D::set_clipmap_update_mode(const ClipmapUpdateMode p_mode) {
+	SET_IF_DIFF(_clipmap_update_mode, p_mode);
+	LOG(INFO, "Setting clipmap update mode: ", _clipmap_update_mode == CLIPMAP_UPDATE_PROCESS ? "Process" : "Physics");
+	if (is_inside_tree()) {
+		_set_processing(is_physics_processing());
+	}
+}
+
+// Returns counters of frame updates, including those skipped because nothing changed
+Dictionary Terrain3D::get_update_stats() const {
+	uint64_t target_updates = 0;
+	uint64_t target_updates_skipped = 0;
+	std::vector<const Terrain3DMesher *> meshers = { _terrain_mesher, _ocean_mesher };
+	meshers.insert(meshers.end(), _viewpoint_meshers.begin(), _viewpoint_meshers.end());
+	for (const Terrain3DMesher *mesher : meshers) {
+		if (mesher) {
+			target_updates += mesher->get_target_updates();
+			target_updates_skipped += mesher->get_target_updates_skipped();
+		}
+	}
+	Dictionary stats;
+	stats["clipmap_updates"] = int64_t(_clipmap_updates);
+	stats["light_updates"] = int64_t(_light_updates);
+	stats["light_updates_skipped"] = int64_t(_light_updates_skipped);
+	stats["target_updates"] = int64_t(target_updates);
+	stats["target_updates_skipped"] = int64_t(target_updates_skipped);
+	return stats;
+}
+
+void Terrain3D::reset_update_stats() {
+	_clipmap_updates = 0;
+	_light_updates = 0;
+	_light_updates_skipped = 0;
+	for (Terrain3DMesher *mesher : { _terrain_mesher, _ocean_mesher }) {
+		if (mesher) {
+			mesher->reset_update_stats();
 		}
 	}
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->reset_update_stats();
+	}
 }
 
 void Terrain3D::snap() {
+	// Resend the light to new or rebuilt materials
+	_light_direction = V3_MAX;
 	if (_terrain_mesher) {
 		_terrain_mesher->reset_target_position();
 	}
+	for (Terrain3DMesher *mesher : _viewpoint_meshers) {
+		mesher->reset_target_position();
+	}
 	if (_ocean_enabled && _ocean_mesher) {
 		_ocean_mesher->reset_target_position();
 	}
@@ -720,7 +1910,7 @@ void Terrain3D::snap() {
 		_collision->reset_target_position();
 	}
 	if (_tessellation_level > 0) {
-		_last_buffer_position = V2_MAX;
+		clear_displacement_buffer();
 	}
 }
 
@@ -766,6 +1956,7 @@ void Terrain3D::set_mesh_size(const int p_size) {
 void Terrain3D::set_vertex_spacing(const real_t p_spacing) {
 	SET_IF_DIFF(_vertex_spacing, CLAMP(p_spacing, 0.25f, 100.0f));
 	LOG(INFO, "Setting vertex spacing: ", _vertex_spacing);
+	clear_nav_cache();
 	if (_collision && _data && _instancer && _material.is_valid()) {
 		_instancer->_update_vertex_spacing(_vertex_spacing);
 		_data->_vertex_spacing = _vertex_spacing;
@@ -775,37 +1966,60 @@ void Terrain3D::set_vertex_spacing(const real_t p_spacing) {
 		_collision->destroy();
 		_collision->build();
 		_update_displacement_buffer();
+		_mark_occluders_dirty();
+		if (_navigation) {
+			_navigation->build();
+		}
+	}
+}
+
+void Terrain3D::set_mesh_mode(const MeshMode p_mode) {
+	SET_IF_DIFF(_mesh_mode, p_mode);
+	LOG(INFO, "Setting mesh mode: ", _mesh_mode == MESH_MODE_CDLOD ? "CDLOD" : "Clipmap");
+	if (_terrain_mesher && _material.is_valid()) {
+		_material->update();
+		_setup_terrain_mesher();
+	}
+	notify_property_list_changed();
+}
+
+void Terrain3D::set_cdlod_lod_distance(const real_t p_distance) {
+	SET_IF_DIFF(_cdlod_lod_distance, CLAMP(p_distance, 3.f, 16.f));
+	LOG(INFO, "Setting CDLOD LOD distance: ", _cdlod_lod_distance);
+	if (_terrain_mesher && _material.is_valid()) {
+		_material->update();
+		_setup_terrain_mesher();
+	}
+}
+
+void Terrain3D::set_multimesh_enabled(const bool p_enabled) {
+	SET_IF_DIFF(_multimesh_enabled, p_enabled);
+	LOG(INFO, "Setting clipmap MultiMesh mode: ", _multimesh_enabled);
+	if (_terrain_mesher && _material.is_valid()) {
+		_setup_terrain_mesher();
 	}
 }
 
 void Terrain3D::set_cull_margin(const real_t p_margin) {
 	SET_IF_DIFF(_cull_margin, CLAMP(p_margin, 0.f, 100000.f));
 	LOG(INFO, "Setting extra cull margin: ", _cull_margin);
-	if (_terrain_mesher) {
-		_terrain_mesher->update_aabbs();
-	}
+	_update_mesher_aabbs();
 }
 
 void Terrain3D::set_cast_shadows(const RenderingServer::ShadowCastingSetting p_cast_shadows) {
 	SET_IF_DIFF(_cast_shadows, p_cast_shadows);
-	if (_terrain_mesher) {
-		_terrain_mesher->update();
-	}
+	_update_terrain_meshers();
 }
 
 void Terrain3D::set_gi_mode(const GeometryInstance3D::GIMode p_gi_mode) {
 	SET_IF_DIFF(_gi_mode, p_gi_mode);
-	if (_terrain_mesher) {
-		_terrain_mesher->update();
-	}
+	_update_terrain_meshers();
 }
 
 void Terrain3D::set_render_layers(const uint32_t p_layers) {
 	SET_IF_DIFF(_render_layers, p_layers);
 	LOG(INFO, "Setting terrain render layers to: ", p_layers);
-	if (_terrain_mesher) {
-		_terrain_mesher->update();
-	}
+	_update_terrain_meshers();
 }
 
 void Terrain3D::set_ocean_enabled(const bool p_enabled) {
@@ -894,6 +2108,7 @@ void Terrain3D::set_ocean_render_layers(const uint32_t p_layers) {
 void Terrain3D::set_ocean_material(const Ref<Material> &p_material) {
 	SET_IF_DIFF(_ocean_material, p_material);
 	LOG(INFO, "Setting ocean material");
+	_light_direction = V3_MAX;
 	if (_ocean_enabled) {
 		_setup_ocean_mesher();
 	}
@@ -1041,6 +2256,41 @@ Dictionary Terrain3D::get_raycast_result(const Vector3 &p_src_pos, const Vector3
 	return space_state->intersect_ray(query);
 }
 
+void Terrain3D::set_navigation_cache(const bool p_enabled) {
+	SET_IF_DIFF(_navigation_cache, p_enabled);
+	LOG(INFO, "Setting navigation cache: ", p_enabled);
+	if (!p_enabled) {
+		clear_nav_cache();
+	}
+}
+
+// Frees all cached navigation source geometry. Called when regions change
+void Terrain3D::clear_nav_cache() {
+	std::lock_guard<std::mutex> lock(_nav_cache_mutex);
+	LOG(INFO, "Clearing navigation cache");
+	_nav_cache.clear();
+	_nav_versions.clear();
+	_nav_cache_epoch++;
+}
+
+void Terrain3D::set_occlusion_enabled(const bool p_enabled) {
+	SET_IF_DIFF(_occlusion_enabled, p_enabled);
+	LOG(INFO, "Setting occlusion enabled: ", p_enabled);
+	if (_occlusion_enabled) {
+		_mark_occluders_dirty();
+	} else {
+		_destroy_occluders();
+	}
+	notify_property_list_changed();
+}
+
+void Terrain3D::set_occlusion_triangle_budget(const int p_budget) {
+	int budget = CLAMP(p_budget, 2, 131072);
+	SET_IF_DIFF(_occlusion_triangle_budget, budget);
+	LOG(INFO, "Setting occlusion triangle budget: ", budget);
+	_mark_occluders_dirty();
+}
+
 /**
  * Generates a static ArrayMesh for the terrain.
  * p_lod (0-8): Determines the granularity of the generated mesh.
@@ -1049,31 +2299,108 @@ Dictionary Terrain3D::get_raycast_result(const Vector3 &p_src_pos, const Vector3
  *  HEIGHT_FILTER_MINIMUM: Samples a range of heights around each vertex and returns the lowest.
  *   This takes longer than ..._NEAREST, but can be used to create occluders, since it can guarantee the
  *   generated mesh will not extend above or outside the clipmap at any LOD.
+ * p_max_error: If > 0, simplifies each region adaptively, so flat areas use fewer, larger triangles. The
+ *  surface stays within this vertical distance of the full mesh at p_lod. Holes are kept exact.
  */
-Ref<Mesh> Terrain3D::bake_mesh(const int p_lod, const Terrain3DData::HeightFilter p_filter) const {
-	LOG(INFO, "Baking mesh at lod: ", p_lod, " with filter: ", p_filter);
-	Ref<Mesh> result;
+Ref<Mesh> Terrain3D::bake_mesh(const int p_lod, const Terrain3DData::HeightFilter p_filter, const real_t p_max_error) const {
+	LOG(INFO, "Baking mesh at lod: ", p_lod, " with filter: ", p_filter, " max error: ", p_max_error);
+	Ref<ArrayMesh> result;
 	ERR_FAIL_COND_V(_data == nullptr, result);
 
-	Ref<SurfaceTool> st;
-	st.instantiate();
-	st->begin(Mesh::PRIMITIVE_TRIANGLES);
-
-	PackedVector3Array vertices;
-	PackedVector2Array uvs;
-	_generate_triangles(vertices, &uvs, p_lod, p_filter, false, AABB());
-
-	ERR_FAIL_COND_V(vertices.size() != uvs.size(), result);
-	for (int i = 0; i < vertices.size(); ++i) {
-		st->set_uv(uvs[i]);
-		st->add_vertex(vertices[i]);
+	MeshArrays arrays;
+	TypedArray<Vector2i> region_locations = _data->get_region_locations();
+	for (const Vector2i &region_loc : region_locations) {
+		_generate_grid(arrays, Rect2i(region_loc * _region_size, V2I(_region_size)), p_lod, p_filter, false, true, p_max_error);
+	}
+	if (arrays.indices.is_empty()) {
+		LOG(WARN, "No terrain to bake");
+		return result;
 	}
+	LOG(DEBUG, "Baked ", arrays.vertices.size(), " vertices, ", arrays.indices.size() / 3, " triangles");
+	result.instantiate();
+	result->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays.get_surface_arrays());
+	return result;
+}
 
-	st->index();
-	st->generate_normals();
-	st->generate_tangents();
-	st->optimize_indices_for_cache();
-	result = st->commit();
+/**
+ * Generates static ArrayMeshes for the terrain in tiles, eg. for HLODs, lightmapping or occluders.
+ * p_tile_size: Tile width in vertices. 0 uses the region size.
+ * p_lods (0-8): One mesh is generated per tile for each lod.
+ * p_filter: See bake_mesh().
+ * p_skirt_depth: If > 0, adds a skirt this deep around each mesh to hide cracks where neighbors differ in lod.
+ * p_save_dir: If set, each mesh is also saved to this directory as chunk_<x>_<y>_lod<lod>.res, and the
+ *  returned meshes reference those files.
+ * Tiles at the same lod share identical border vertices and normals, since heights are read across tile
+ * boundaries. Returns a Dictionary of tile location:Vector2i -> Array[Mesh] ordered as p_lods, omitting
+ * empty tiles. Tiles are built on the WorkerThreadPool.
+ */
+Dictionary Terrain3D::bake_mesh_chunks(const int p_tile_size, const PackedInt32Array &p_lods,
+		const Terrain3DData::HeightFilter p_filter, const real_t p_skirt_depth, const String &p_save_dir) const {
+	Dictionary result;
+	ERR_FAIL_COND_V(_data == nullptr, result);
+	ERR_FAIL_COND_V(p_lods.is_empty(), result);
+	if (!p_save_dir.is_empty() && !DirAccess::dir_exists_absolute(p_save_dir)) {
+		Error err = DirAccess::make_dir_recursive_absolute(p_save_dir);
+		if (err != OK) {
+			LOG(ERROR, "Cannot create directory: ", p_save_dir, ", error: ", UtilityFunctions::error_string(err), " (", err, ")");
+			return result;
+		}
+	}
+	const int32_t tile_size = (p_tile_size > 0) ? p_tile_size : int32_t(_region_size);
+	LOG(INFO, "Baking mesh chunks of size: ", tile_size, " at lods: ", p_lods, " with filter: ", p_filter);
+
+	// Find tiles overlapping any region
+	std::vector<Vector2i> tiles;
+	TypedArray<Vector2i> region_locations = _data->get_region_locations();
+	for (const Vector2i &region_loc : region_locations) {
+		Vector2i region_pos = region_loc * _region_size;
+		Vector2i start = V2I_DIVIDE_FLOOR(region_pos, tile_size);
+		Vector2i region_end = region_pos + V2I(_region_size);
+		Vector2i end = V2I_DIVIDE_CEIL(region_end, tile_size);
+		for (int32_t y = start.y; y < end.y; y++) {
+			for (int32_t x = start.x; x < end.x; x++) {
+				tiles.push_back(Vector2i(x, y));
+			}
+		}
+	}
+	std::sort(tiles.begin(), tiles.end());
+	tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+	// Build every tile and lod in parallel, then create the meshes on this thread
+	const int lod_count = p_lods.size();
+	std::vector<MeshArrays> jobs(tiles.size() * lod_count);
+	parallel_for(int(jobs.size()), [&](const int p_index) {
+		const Rect2i area = Rect2i(tiles[p_index / lod_count] * tile_size, V2I(tile_size));
+		const int32_t lod = p_lods[p_index % lod_count];
+		_generate_grid(jobs[p_index], area, lod, p_filter, false, true);
+		_generate_skirt(jobs[p_index], area, lod, p_skirt_depth);
+	});
+	for (size_t t = 0; t < tiles.size(); t++) {
+		Array meshes;
+		bool empty = true;
+		for (int l = 0; l < lod_count; l++) {
+			const MeshArrays &arrays = jobs[t * lod_count + l];
+			Ref<ArrayMesh> mesh;
+			if (!arrays.indices.is_empty()) {
+				mesh.instantiate();
+				mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays.get_surface_arrays());
+				empty = false;
+				if (!p_save_dir.is_empty()) {
+					const String path = p_save_dir.path_join(vformat("chunk_%d_%d_lod%d.res", tiles[t].x, tiles[t].y, p_lods[l]));
+					mesh->take_over_path(path);
+					Error err = ResourceSaver::get_singleton()->save(mesh, path, ResourceSaver::FLAG_COMPRESS);
+					if (err != OK) {
+						LOG(ERROR, "Could not save file: ", path, ", error: ", UtilityFunctions::error_string(err), " (", err, ")");
+					}
+				}
+			}
+			meshes.push_back(mesh);
+		}
+		if (!empty) {
+			result[tiles[t]] = meshes;
+		}
+	}
+	LOG(DEBUG, "Baked ", result.size(), " tiles");
 	return result;
 }
 
@@ -1085,14 +2412,55 @@ Ref<Mesh> Terrain3D::bake_mesh(const int p_lod, const Terrain3DData::HeightFilte
  * p_require_nav: If true, this function will only generate geometry for terrain marked navigable.
  *  Otherwise, geometry is generated for the entire terrain within the AABB (which can be useful for
  *  dynamic and/or runtime nav mesh baking).
+ * p_max_error: If > 0, simplifies tiles of NAV_TILE_SIZE vertices adaptively within this vertical error,
+ *  keeping holes, navigation boundaries and tile edges exact. With an AABB, overlapping tiles are simplified
+ *  whole, and only faces touching it kept.
+ * p_instances: If true, appends obstacle faces for instancer meshes within the AABB. See
+ *  Terrain3DInstancer::generate_nav_obstacle_faces().
  */
-PackedVector3Array Terrain3D::generate_nav_mesh_source_geometry(const AABB &p_global_aabb, const bool p_require_nav) const {
+PackedVector3Array Terrain3D::generate_nav_mesh_source_geometry(const AABB &p_global_aabb, const bool p_require_nav,
+		const real_t p_max_error, const bool p_instances) const {
 	LOG(INFO, "Generating NavMesh source geometry from terrain");
 	PackedVector3Array faces;
-	_generate_triangles(faces, nullptr, 0, Terrain3DData::HEIGHT_FILTER_NEAREST, p_require_nav, p_global_aabb);
+	MeshArrays arrays;
+	_generate_nav_arrays(arrays, p_global_aabb, p_require_nav, p_max_error);
+	faces.resize(arrays.indices.size());
+	const Vector3 *vertices = arrays.vertices.ptr();
+	const int32_t *indices = arrays.indices.ptr();
+	Vector3 *dst = faces.ptrw();
+	for (int64_t i = 0; i < arrays.indices.size(); i++) {
+		dst[i] = vertices[indices[i]];
+	}
+	if (p_instances && _instancer) {
+		faces.append_array(_instancer->generate_nav_obstacle_faces(p_global_aabb));
+	}
 	return faces;
 }
 
+/**
+ * Same as generate_nav_mesh_source_geometry(), but returns indexed arrays, eg. for
+ * NavigationMeshSourceGeometryData3D.add_mesh_array(). Vertices are shared between faces, so this is
+ * smaller and faster to bake than the faces.
+ */
+Array Terrain3D::generate_nav_mesh_source_arrays(const AABB &p_global_aabb, const bool p_require_nav,
+		const real_t p_max_error, const bool p_instances) const {
+	LOG(INFO, "Generating NavMesh source arrays from terrain");
+	MeshArrays arrays;
+	_generate_nav_arrays(arrays, p_global_aabb, p_require_nav, p_max_error);
+	if (p_instances && _instancer) {
+		// Obstacle faces don't share vertices
+		const PackedVector3Array faces = _instancer->generate_nav_obstacle_faces(p_global_aabb);
+		const int32_t base = int32_t(arrays.vertices.size());
+		arrays.vertices.append_array(faces);
+		arrays.indices.resize(arrays.indices.size() + faces.size());
+		int32_t *indices = arrays.indices.ptrw() + arrays.indices.size() - faces.size();
+		for (int32_t i = 0; i < int32_t(faces.size()); i++) {
+			indices[i] = base + i;
+		}
+	}
+	return arrays.get_surface_arrays();
+}
+
 void Terrain3D::set_warning(const uint8_t p_warning, const bool p_enabled) {
 	if (p_enabled) {
 		_warnings |= p_warning;
@@ -1141,9 +2509,7 @@ void Terrain3D::_notification(const int p_what) {
 			// Sent on scene changes
 			LOG(INFO, "NOTIFICATION_ENTER_WORLD");
 			_is_inside_world = true;
-			if (_terrain_mesher) {
-				_terrain_mesher->update();
-			}
+			_update_terrain_meshers();
 			break;
 		}
 
@@ -1162,7 +2528,7 @@ void Terrain3D::_notification(const int p_what) {
 				_assets = ResourceLoader::get_singleton()->load(_assets->get_path(), "", ResourceLoader::CACHE_MODE_IGNORE);
 			}
 			_initialize(); // Rebuild anything freed: meshes, collision, instancer
-			set_physics_process(true);
+			_set_processing(true);
 			break;
 		}
 
@@ -1172,6 +2538,8 @@ void Terrain3D::_notification(const int p_what) {
 			// Optional: Run the testing suite
 			//#include "unit_testing.h"
 			//test_differs();
+			//test_triangulate_rtin();
+			//test_get_mesh_vertex();
 
 			// Clear editor textures - also see ENTER_TREE
 			if (_free_editor_textures && !IS_EDITOR && _assets.is_valid()) {
@@ -1187,6 +2555,12 @@ void Terrain3D::_notification(const int p_what) {
 
 			/// Game Loop notifications
 
+		case NOTIFICATION_PROCESS: {
+			// Node is processing one frame
+			__process(get_process_delta_time());
+			break;
+		}
+
 		case NOTIFICATION_PHYSICS_PROCESS: {
 			// Node is processing one physics frame
 			__physics_process(get_physics_process_delta_time());
@@ -1204,9 +2578,7 @@ void Terrain3D::_notification(const int p_what) {
 		case NOTIFICATION_VISIBILITY_CHANGED: {
 			// Node3D visibility changed
 			LOG(INFO, "NOTIFICATION_VISIBILITY_CHANGED");
-			if (_terrain_mesher) {
-				_terrain_mesher->update();
-			}
+			_update_terrain_meshers();
 			if (_ocean_mesher) {
 				_ocean_mesher->update();
 			}
@@ -1217,6 +2589,9 @@ void Terrain3D::_notification(const int p_what) {
 					_instancer->update_mmis(-1, V2I_MAX, true);
 				}
 			}
+			for (const std::pair<const Vector2i, RegionOccluder> &entry : _occluders) {
+				RS->instance_set_visible(entry.second.instance, is_visible_in_tree());
+			}
 			break;
 		}
 
@@ -1267,10 +2642,12 @@ void Terrain3D::_notification(const int p_what) {
 			// Node is about to exit a SceneTree
 			// Sent on scene changes
 			LOG(INFO, "NOTIFICATION_EXIT_TREE");
-			set_physics_process(false);
+			_set_processing(false);
 			_destroy_terrain_mesher();
 			_destroy_ocean_mesher();
 			_destroy_instancer();
+			_destroy_occluders();
+			_destroy_navigation();
 			_destroy_mouse_picking();
 			_destroy_displacement_buffer();
 			if (_assets.is_valid()) {
@@ -1297,6 +2674,8 @@ void Terrain3D::_notification(const int p_what) {
 			_destroy_terrain_mesher(true);
 			_destroy_ocean_mesher(true);
 			_destroy_instancer();
+			_destroy_occluders();
+			_destroy_navigation(true);
 			_destroy_collision(true);
 			_assets.unref();
 			_material.unref();
@@ -1321,6 +2700,13 @@ void Terrain3D::_validate_property(PropertyInfo &p_property) const {
 			p_property.usage = PROPERTY_USAGE_NO_EDITOR;
 		}
 	}
+	if (_mesh_mode != MESH_MODE_CDLOD && p_property.name == StringName("cdlod_lod_distance")) {
+		p_property.usage = PROPERTY_USAGE_NO_EDITOR;
+	}
+	// Hide occlusion settings if not enabled
+	if (!_occlusion_enabled && p_property.name == StringName("occlusion_triangle_budget")) {
+		p_property.usage = PROPERTY_USAGE_NO_EDITOR;
+	}
 	// Hide all ocean properties if not enabled
 	if (!_ocean_enabled && p_property.name != StringName("ocean_enabled") &&
 			p_property.name.begins_with("ocean_")) {
@@ -1341,6 +2727,12 @@ void Terrain3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(SIZE_1024);
 	BIND_ENUM_CONSTANT(SIZE_2048);
 
+	BIND_ENUM_CONSTANT(MESH_MODE_CLIPMAP);
+	BIND_ENUM_CONSTANT(MESH_MODE_CDLOD);
+
+	BIND_ENUM_CONSTANT(CLIPMAP_UPDATE_PHYSICS);
+	BIND_ENUM_CONSTANT(CLIPMAP_UPDATE_PROCESS);
+
 	ClassDB::bind_method(D_METHOD("get_version"), &Terrain3D::get_version);
 	ClassDB::bind_method(D_METHOD("set_debug_level", "level"), &Terrain3D::set_debug_level);
 	ClassDB::bind_method(D_METHOD("get_debug_level"), &Terrain3D::get_debug_level);
@@ -1355,6 +2747,7 @@ void Terrain3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_assets"), &Terrain3D::get_assets);
 	ClassDB::bind_method(D_METHOD("get_collision"), &Terrain3D::get_collision);
 	ClassDB::bind_method(D_METHOD("get_instancer"), &Terrain3D::get_instancer);
+	ClassDB::bind_method(D_METHOD("get_navigation"), &Terrain3D::get_navigation);
 	ClassDB::bind_method(D_METHOD("set_editor", "editor"), &Terrain3D::set_editor);
 	ClassDB::bind_method(D_METHOD("get_editor"), &Terrain3D::get_editor);
 	ClassDB::bind_method(D_METHOD("set_plugin", "plugin"), &Terrain3D::set_plugin);
@@ -1381,7 +2774,15 @@ void Terrain3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_collision_target_position"), &Terrain3D::get_collision_target_position);
 	ClassDB::bind_method(D_METHOD("set_light_target", "node"), &Terrain3D::set_light_target);
 	ClassDB::bind_method(D_METHOD("get_light_target"), &Terrain3D::get_light_target);
+	ClassDB::bind_method(D_METHOD("set_clipmap_update_mode", "mode"), &Terrain3D::set_clipmap_update_mode);
+	ClassDB::bind_method(D_METHOD("get_clipmap_update_mode"), &Terrain3D::get_clipmap_update_mode);
+	ClassDB::bind_method(D_METHOD("get_update_stats"), &Terrain3D::get_update_stats);
+	ClassDB::bind_method(D_METHOD("reset_update_stats"), &Terrain3D::reset_update_stats);
 	ClassDB::bind_method(D_METHOD("snap"), &Terrain3D::snap);
+	ClassDB::bind_method(D_METHOD("get_clipmap_snap_calls"), &Terrain3D::get_clipmap_snap_calls);
+	ClassDB::bind_method(D_METHOD("add_clipmap_viewpoint", "target", "render_layers"), &Terrain3D::add_clipmap_viewpoint);
+	ClassDB::bind_method(D_METHOD("remove_clipmap_viewpoint", "target"), &Terrain3D::remove_clipmap_viewpoint);
+	ClassDB::bind_method(D_METHOD("get_clipmap_viewpoints"), &Terrain3D::get_clipmap_viewpoints);
 
 	// Collision
 	ClassDB::bind_method(D_METHOD("set_collision_mode", "mode"), &Terrain3D::set_collision_mode);
@@ -1408,6 +2809,12 @@ void Terrain3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_tessellation_level"), &Terrain3D::get_tessellation_level);
 	ClassDB::bind_method(D_METHOD("set_vertex_spacing", "scale"), &Terrain3D::set_vertex_spacing);
 	ClassDB::bind_method(D_METHOD("get_vertex_spacing"), &Terrain3D::get_vertex_spacing);
+	ClassDB::bind_method(D_METHOD("set_mesh_mode", "mode"), &Terrain3D::set_mesh_mode);
+	ClassDB::bind_method(D_METHOD("get_mesh_mode"), &Terrain3D::get_mesh_mode);
+	ClassDB::bind_method(D_METHOD("set_cdlod_lod_distance", "distance"), &Terrain3D::set_cdlod_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_cdlod_lod_distance"), &Terrain3D::get_cdlod_lod_distance);
+	ClassDB::bind_method(D_METHOD("set_multimesh_enabled", "enabled"), &Terrain3D::set_multimesh_enabled);
+	ClassDB::bind_method(D_METHOD("is_multimesh_enabled"), &Terrain3D::is_multimesh_enabled);
 	ClassDB::bind_method(D_METHOD("set_cull_margin", "margin"), &Terrain3D::set_cull_margin);
 	ClassDB::bind_method(D_METHOD("get_cull_margin"), &Terrain3D::get_cull_margin);
 	ClassDB::bind_method(D_METHOD("set_cast_shadows", "shadow_casting_setting"), &Terrain3D::set_cast_shadows);
@@ -1457,6 +2864,31 @@ void Terrain3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_instancer_mode", "mode"), &Terrain3D::set_instancer_mode);
 	ClassDB::bind_method(D_METHOD("get_instancer_mode"), &Terrain3D::get_instancer_mode);
 
+	// Occlusion
+	ClassDB::bind_method(D_METHOD("set_occlusion_enabled", "enabled"), &Terrain3D::set_occlusion_enabled);
+	ClassDB::bind_method(D_METHOD("is_occlusion_enabled"), &Terrain3D::is_occlusion_enabled);
+	ClassDB::bind_method(D_METHOD("set_occlusion_triangle_budget", "budget"), &Terrain3D::set_occlusion_triangle_budget);
+	ClassDB::bind_method(D_METHOD("get_occlusion_triangle_budget"), &Terrain3D::get_occlusion_triangle_budget);
+
+	// Navigation
+	ClassDB::bind_method(D_METHOD("set_navigation_cache", "enabled"), &Terrain3D::set_navigation_cache);
+	ClassDB::bind_method(D_METHOD("get_navigation_cache"), &Terrain3D::get_navigation_cache);
+	ClassDB::bind_method(D_METHOD("set_navigation_baking", "enabled"), &Terrain3D::set_navigation_baking);
+	ClassDB::bind_method(D_METHOD("get_navigation_baking"), &Terrain3D::get_navigation_baking);
+	ClassDB::bind_method(D_METHOD("set_navigation_template", "template"), &Terrain3D::set_navigation_template);
+	ClassDB::bind_method(D_METHOD("get_navigation_template"), &Terrain3D::get_navigation_template);
+	ClassDB::bind_method(D_METHOD("set_navigation_tile_size", "size"), &Terrain3D::set_navigation_tile_size);
+	ClassDB::bind_method(D_METHOD("get_navigation_tile_size"), &Terrain3D::get_navigation_tile_size);
+	ClassDB::bind_method(D_METHOD("set_navigation_radius", "radius"), &Terrain3D::set_navigation_radius);
+	ClassDB::bind_method(D_METHOD("get_navigation_radius"), &Terrain3D::get_navigation_radius);
+	ClassDB::bind_method(D_METHOD("set_navigation_layers", "layers"), &Terrain3D::set_navigation_layers);
+	ClassDB::bind_method(D_METHOD("get_navigation_layers"), &Terrain3D::get_navigation_layers);
+	ClassDB::bind_method(D_METHOD("set_navigation_require_nav", "require_nav"), &Terrain3D::set_navigation_require_nav);
+	ClassDB::bind_method(D_METHOD("get_navigation_require_nav"), &Terrain3D::get_navigation_require_nav);
+	ClassDB::bind_method(D_METHOD("set_navigation_instances", "enabled"), &Terrain3D::set_navigation_instances);
+	ClassDB::bind_method(D_METHOD("get_navigation_instances"), &Terrain3D::get_navigation_instances);
+	ClassDB::bind_method(D_METHOD("clear_nav_cache"), &Terrain3D::clear_nav_cache);
+
 	// Overlays
 	ClassDB::bind_method(D_METHOD("set_show_region_grid", "enabled"), &Terrain3D::set_show_region_grid);
 	ClassDB::bind_method(D_METHOD("get_show_region_grid"), &Terrain3D::get_show_region_grid);
@@ -1511,8 +2943,10 @@ void Terrain3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_intersection", "src_pos", "direction", "gpu_mode"), &Terrain3D::get_intersection, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_raycast_result", "src_pos", "direction", "collision_mask", "exclude_terrain"),
 			&Terrain3D::get_raycast_result, DEFVAL(0xFFFFFFFF), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("bake_mesh", "lod", "filter"), &Terrain3D::bake_mesh, DEFVAL(Terrain3DData::HEIGHT_FILTER_NEAREST));
-	ClassDB::bind_method(D_METHOD("generate_nav_mesh_source_geometry", "global_aabb", "require_nav"), &Terrain3D::generate_nav_mesh_source_geometry, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("bake_mesh", "lod", "filter", "max_error"), &Terrain3D::bake_mesh, DEFVAL(Terrain3DData::HEIGHT_FILTER_NEAREST), DEFVAL(0.f));
+	ClassDB::bind_method(D_METHOD("bake_mesh_chunks", "tile_size", "lods", "filter", "skirt_depth", "save_dir"), &Terrain3D::bake_mesh_chunks, DEFVAL(Terrain3DData::HEIGHT_FILTER_NEAREST), DEFVAL(0.f), DEFVAL(""));
+	ClassDB::bind_method(D_METHOD("generate_nav_mesh_source_geometry", "global_aabb", "require_nav", "max_error", "instances"), &Terrain3D::generate_nav_mesh_source_geometry, DEFVAL(true), DEFVAL(0.f), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("generate_nav_mesh_source_arrays", "global_aabb", "require_nav", "max_error", "instances"), &Terrain3D::generate_nav_mesh_source_arrays, DEFVAL(true), DEFVAL(0.f), DEFVAL(false));
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "version", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR | PROPERTY_USAGE_READ_ONLY), "", "get_version");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "debug_level", PROPERTY_HINT_ENUM, "Errors,Info,Debug,Extreme"), "set_debug_level", "get_debug_level");
@@ -1523,6 +2957,7 @@ void Terrain3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "assets", PROPERTY_HINT_RESOURCE_TYPE, "Terrain3DAssets"), "set_assets", "get_assets");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, "Terrain3DData"), "", "get_data");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "collision", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, "Terrain3DCollision"), "", "get_collision");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "navigation", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, "Terrain3DNavigation"), "", "get_navigation");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "instancer", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, "Terrain3DInstancer"), "", "get_instancer");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "light_target", PROPERTY_HINT_NODE_TYPE, "DirectionalLight3D", PROPERTY_USAGE_DEFAULT, "Node3D"), "set_light_target", "get_light_target");
 
@@ -1545,10 +2980,14 @@ void Terrain3D::_bind_methods() {
 
 	ADD_GROUP("Terrain Mesh", "");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "clipmap_target", PROPERTY_HINT_NODE_TYPE, "Node3D", PROPERTY_USAGE_DEFAULT, "Node3D"), "set_clipmap_target", "get_clipmap_target");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "clipmap_update_mode", PROPERTY_HINT_ENUM, "Physics,Process"), "set_clipmap_update_mode", "get_clipmap_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "mesh_mode", PROPERTY_HINT_ENUM, "Clipmap,CDLOD"), "set_mesh_mode", "get_mesh_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cdlod_lod_distance", PROPERTY_HINT_RANGE, "3.0,16.0,0.1"), "set_cdlod_lod_distance", "get_cdlod_lod_distance");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "mesh_lods", PROPERTY_HINT_RANGE, "1,10,1"), "set_mesh_lods", "get_mesh_lods");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "tessellation_level", PROPERTY_HINT_RANGE, "0,6,1"), "set_tessellation_level", "get_tessellation_level");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "mesh_size", PROPERTY_HINT_RANGE, "8,256,2"), "set_mesh_size", "get_mesh_size");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "vertex_spacing", PROPERTY_HINT_RANGE, "0.25,10.0,or_greater"), "set_vertex_spacing", "get_vertex_spacing");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multimesh_enabled"), "set_multimesh_enabled", "is_multimesh_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cull_margin", PROPERTY_HINT_RANGE, "0.0,10000.0,.5,or_greater"), "set_cull_margin", "get_cull_margin");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "cast_shadows", PROPERTY_HINT_ENUM, "Off,On,Double-Sided,Shadows Only"), "set_cast_shadows", "get_cast_shadows");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "gi_mode", PROPERTY_HINT_ENUM, "Disabled,Static,Dynamic"), "set_gi_mode", "get_gi_mode");
@@ -1577,6 +3016,20 @@ void Terrain3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "free_editor_textures"), "set_free_editor_textures", "get_free_editor_textures");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "instancer_mode", PROPERTY_HINT_ENUM, "Disabled,Normal"), "set_instancer_mode", "get_instancer_mode");
 
+	ADD_GROUP("Occlusion", "occlusion_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "occlusion_enabled"), "set_occlusion_enabled", "is_occlusion_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "occlusion_triangle_budget", PROPERTY_HINT_RANGE, "2,131072,1"), "set_occlusion_triangle_budget", "get_occlusion_triangle_budget");
+
+	ADD_GROUP("Navigation", "");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_cache"), "set_navigation_cache", "get_navigation_cache");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_baking"), "set_navigation_baking", "get_navigation_baking");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "navigation_template", PROPERTY_HINT_RESOURCE_TYPE, "NavigationMesh"), "set_navigation_template", "get_navigation_template");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "navigation_tile_size", PROPERTY_HINT_RANGE, "8,1024,1"), "set_navigation_tile_size", "get_navigation_tile_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "navigation_radius", PROPERTY_HINT_RANGE, "0,8192,1"), "set_navigation_radius", "get_navigation_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "navigation_layers", PROPERTY_HINT_LAYERS_3D_NAVIGATION), "set_navigation_layers", "get_navigation_layers");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_require_nav"), "set_navigation_require_nav", "get_navigation_require_nav");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_instances"), "set_navigation_instances", "get_navigation_instances");
+
 	ADD_GROUP("Overlays", "show_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_region_grid"), "set_show_region_grid", "get_show_region_grid");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_instancer_grid"), "set_show_instancer_grid", "get_show_instancer_grid");
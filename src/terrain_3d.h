@@ -4,13 +4,17 @@
 #define TERRAIN3D_CLASS_H
 
 #include <godot_cpp/classes/camera3d.hpp>
-#include <godot_cpp/classes/color_rect.hpp>
 #include <godot_cpp/classes/geometry_instance3d.hpp>
 #include <godot_cpp/classes/mesh.hpp>
 #include <godot_cpp/classes/mesh_instance3d.hpp>
 #include <godot_cpp/classes/object.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/classes/sub_viewport.hpp>
+#include <cfloat>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "constants.h"
 #include "target_node_3d.h"
@@ -21,6 +25,7 @@
 #include "terrain_3d_instancer.h"
 #include "terrain_3d_material.h"
 #include "terrain_3d_mesher.h"
+#include "terrain_3d_navigation.h"
 
 class Terrain3D : public Node3D {
 	GDCLASS(Terrain3D, Node3D);
@@ -45,6 +50,16 @@ public: // Constants
 		SIZE_2048 = 2048,
 	};
 
+	enum MeshMode {
+		MESH_MODE_CLIPMAP,
+		MESH_MODE_CDLOD,
+	};
+
+	enum ClipmapUpdateMode {
+		CLIPMAP_UPDATE_PHYSICS,
+		CLIPMAP_UPDATE_PROCESS,
+	};
+
 private:
 	String _version = "1.1.0-dev";
 	String _data_directory;
@@ -57,6 +72,7 @@ private:
 	Ref<Terrain3DAssets> _assets;
 	Terrain3DCollision *_collision = nullptr;
 	Terrain3DInstancer *_instancer = nullptr;
+	Terrain3DNavigation *_navigation = nullptr;
 	Terrain3DEditor *_editor = nullptr;
 	Object *_editor_plugin = nullptr;
 
@@ -72,6 +88,20 @@ private:
 	TargetNode3D _light_target;
 	TargetNode3D _camera; // Fallback target for clipmap and collision
 
+	// Frame updates
+	ClipmapUpdateMode _clipmap_update_mode = CLIPMAP_UPDATE_PHYSICS;
+	// Last light values sent to the materials, to skip unchanged updates
+	Color _light_color = Color(0.f, 0.f, 0.f, 0.f);
+	Vector3 _light_direction = V3_MAX;
+	uint64_t _clipmap_updates = 0;
+	uint64_t _light_updates = 0;
+	uint64_t _light_updates_skipped = 0;
+	// Mesher AABB refreshes requested since the last one, done once at the end of the frame. Edits refresh
+	// only the instances overlapping the edited area, unless the maps were regenerated.
+	bool _mesher_aabbs_dirty = false;
+	bool _mesher_aabbs_full = false;
+	Rect2 _mesher_aabbs_area;
+
 	// Terrain Mesh
 	Terrain3DMesher *_terrain_mesher = nullptr;
 	Ref<Terrain3DMaterial> _material;
@@ -79,14 +109,22 @@ private:
 	int _tessellation_level = 0;
 	int _mesh_size = 48;
 	real_t _vertex_spacing = 1.0f;
+	bool _multimesh_enabled = false;
+	MeshMode _mesh_mode = MESH_MODE_CLIPMAP;
+	real_t _cdlod_lod_distance = 3.f;
+	// Clipmap rings for additional viewpoints, sharing the meshes of _terrain_mesher
+	std::vector<Terrain3DMesher *> _viewpoint_meshers;
 	real_t _cull_margin = 0.0f;
 	RenderingServer::ShadowCastingSetting _cast_shadows = RenderingServer::SHADOW_CASTING_SETTING_ON;
 	GeometryInstance3D::GIMode _gi_mode = GeometryInstance3D::GI_MODE_STATIC;
 	uint32_t _render_layers = 1u | (1u << 31u); // Bit 1 and 32 for the cursor
 
 	// Displacement Buffer
+	// Each LOD tile is addressed toroidally, so texels keep their world position while the target
+	// moves and only the strips it moves into are rendered
 	SubViewport *_d_buffer_vp = nullptr;
-	ColorRect *_d_buffer_rect = nullptr;
+	RID _d_buffer_canvas_item;
+	std::vector<Vector2i> _d_buffer_origins; // First texel of each tile's window, V2I_MAX if not rendered
 	Vector2 _last_buffer_position = V2_MAX;
 
 	// Ocean Mesh
@@ -112,14 +150,66 @@ private:
 	// Parent containers for child nodes
 	Node3D *_label_parent;
 
+	// Baked Meshes
+	// Indexed triangle arrays built by _generate_grid(). Attributes other than vertices and indices are optional.
+	struct MeshArrays {
+		PackedVector3Array vertices;
+		PackedVector3Array normals;
+		PackedFloat32Array tangents;
+		PackedVector2Array uvs;
+		PackedInt32Array indices;
+
+		Array get_surface_arrays() const;
+	};
+
+	// Navigation
+	// Source geometry cache in tiles of NAV_TILE_SIZE vertices. Entries are valid while their epoch and version
+	// match the current ones, so tiles built while an edit lands aren't kept. Guarded by _nav_cache_mutex, as
+	// generation may run on other threads.
+	static inline const int NAV_TILE_SIZE = 64;
+	struct NavCacheTile {
+		uint64_t epoch = 0;
+		uint32_t version = 0;
+		MeshArrays arrays;
+	};
+	bool _navigation_cache = false;
+	mutable std::mutex _nav_cache_mutex;
+	mutable std::unordered_map<Vector2i, NavCacheTile, Vector2iHash> _nav_cache;
+	mutable std::unordered_map<Vector2i, uint32_t, Vector2iHash> _nav_versions;
+	mutable uint64_t _nav_cache_epoch = 0;
+	mutable bool _nav_cache_require_nav = true;
+	mutable real_t _nav_cache_max_error = 0.f;
+
+	// Occlusion
+	// One occluder per region, rebuilt on the next physics frame after its maps change
+	struct RegionOccluder {
+		RID occluder;
+		RID instance;
+	};
+	bool _occlusion_enabled = false;
+	int _occlusion_triangle_budget = 2048;
+	std::unordered_map<Vector2i, RegionOccluder, Vector2iHash> _occluders;
+	std::unordered_set<Vector2i, Vector2iHash> _dirty_occluders;
+	bool _occluders_dirty = false;
+
 	void _initialize();
+	void __process(const double p_delta);
 	void __physics_process(const double p_delta);
+	void _set_processing(const bool p_enabled);
+	void _update_clipmap();
+	void _update_light();
 	void _grab_camera();
 
 	void _destroy_collision(const bool p_final = false);
+	void _destroy_navigation(const bool p_final = false);
 
 	void _setup_terrain_mesher();
-	void _update_mesher_aabbs() { _terrain_mesher ? _terrain_mesher->update_aabbs() : void(); }
+	void _update_terrain_meshers();
+	void _update_mesher_aabbs();
+	void _mark_mesher_aabbs_dirty();
+	void _mark_mesher_aabbs_full();
+	void _mark_mesher_aabbs_edited(const AABB &p_global_aabb);
+	void _refresh_mesher_aabbs();
 	void _destroy_terrain_mesher(const bool p_final = false);
 	void _setup_ocean_mesher();
 	void _update_ocean_aabbs() { _ocean_mesher ? _ocean_mesher->update_aabbs() : void(); }
@@ -127,6 +217,8 @@ private:
 
 	void _setup_displacement_buffer();
 	void _update_displacement_buffer();
+	void _render_displacement_buffer(const Vector3 &p_target_pos);
+	void _invalidate_displacement_buffer(const AABB &p_global_aabb);
 	void _destroy_displacement_buffer();
 
 	void _build_containers();
@@ -137,10 +229,24 @@ private:
 	void _destroy_mouse_picking();
 	void _destroy_instancer();
 
-	void _generate_triangles(PackedVector3Array &p_vertices, PackedVector2Array *p_uvs, const int32_t p_lod,
-			const Terrain3DData::HeightFilter p_filter, const bool require_nav, const AABB &p_global_aabb) const;
-	void _generate_triangle_pair(PackedVector3Array &p_vertices, PackedVector2Array *p_uvs, const int32_t p_lod,
-			const Terrain3DData::HeightFilter p_filter, const bool require_nav, const int32_t x, const int32_t z) const;
+	void _generate_grid(MeshArrays &r_arrays, const Rect2i &p_area, const int32_t p_lod,
+			const Terrain3DData::HeightFilter p_filter, const bool p_require_nav, const bool p_attributes,
+			const real_t p_max_error = 0.f,
+			const Vector2 &p_height_range = Vector2(-FLT_MAX, FLT_MAX)) const;
+	static void _triangulate_rtin(std::vector<int32_t> &r_triangles, const int32_t p_size, const std::vector<float> &p_heights,
+			const std::vector<uint8_t> &p_tris, const real_t p_max_error);
+	friend void test_triangulate_rtin();
+	void _generate_nav_arrays(MeshArrays &r_arrays, const AABB &p_global_aabb, const bool p_require_nav,
+			const real_t p_max_error) const;
+	void _generate_nav_arrays_tiled(MeshArrays &r_arrays, const AABB &p_global_aabb, const bool p_require_nav,
+			const real_t p_max_error) const;
+	void _invalidate_nav_cache(const AABB &p_global_aabb);
+	void _generate_skirt(MeshArrays &r_arrays, const Rect2i &p_area, const int32_t p_lod, const real_t p_depth) const;
+	void _generate_occluder_arrays(MeshArrays &r_arrays, const Vector2i &p_region_loc) const;
+	void _mark_occluders_dirty();
+	void _invalidate_occluders(const AABB &p_global_aabb);
+	void _update_occluders();
+	void _destroy_occluders();
 
 public:
 	static DebugLevel debug_level; // Initialized in terrain_3d.cpp
@@ -162,6 +268,7 @@ public:
 	Ref<Terrain3DAssets> get_assets() const { return _assets; }
 	Terrain3DCollision *get_collision() const { return _collision; }
 	Terrain3DInstancer *get_instancer() const { return _instancer; }
+	Terrain3DNavigation *get_navigation() const { return _navigation; }
 	void set_editor(Terrain3DEditor *p_editor);
 	Terrain3DEditor *get_editor() const { return _editor; }
 	void set_plugin(Object *p_plugin);
@@ -190,7 +297,12 @@ public:
 	Vector3 get_collision_target_position() const;
 	void set_light_target(Node3D *p_node);
 	Node3D *get_light_target() const { return _light_target.ptr(); }
+	void set_clipmap_update_mode(const ClipmapUpdateMode p_mode);
+	ClipmapUpdateMode get_clipmap_update_mode() const { return _clipmap_update_mode; }
+	Dictionary get_update_stats() const;
+	void reset_update_stats();
 	void snap();
+	void clear_displacement_buffer();
 
 	// Collision Aliases
 	void set_collision_mode(const CollisionMode p_mode) { _collision ? _collision->set_mode(p_mode) : void(); }
@@ -210,6 +322,10 @@ public:
 
 	// Terrain Mesh
 	Terrain3DMesher *get_mesher() const { return _terrain_mesher; }
+	int get_clipmap_snap_calls() const { return _terrain_mesher ? _terrain_mesher->get_snap_calls() : 0; }
+	void add_clipmap_viewpoint(Node3D *p_target, const uint32_t p_render_layers);
+	void remove_clipmap_viewpoint(Node3D *p_target);
+	TypedArray<Node3D> get_clipmap_viewpoints() const;
 	void set_material(const Ref<Terrain3DMaterial> &p_material);
 	Ref<Terrain3DMaterial> get_material() const { return _material; }
 	void set_mesh_lods(const int p_count);
@@ -220,6 +336,12 @@ public:
 	int get_mesh_size() const { return _mesh_size; }
 	void set_vertex_spacing(const real_t p_spacing);
 	real_t get_vertex_spacing() const { return _vertex_spacing; }
+	void set_multimesh_enabled(const bool p_enabled);
+	bool is_multimesh_enabled() const { return _multimesh_enabled; }
+	void set_mesh_mode(const MeshMode p_mode);
+	MeshMode get_mesh_mode() const { return _mesh_mode; }
+	void set_cdlod_lod_distance(const real_t p_distance);
+	real_t get_cdlod_lod_distance() const { return _cdlod_lod_distance; }
 	void set_cull_margin(const real_t p_margin);
 	real_t get_cull_margin() const { return _cull_margin; }
 	void set_cast_shadows(const RenderingServer::ShadowCastingSetting p_cast_shadows);
@@ -270,11 +392,45 @@ public:
 	void set_instancer_mode(const InstancerMode p_mode) { _instancer ? _instancer->set_mode(p_mode) : void(); }
 	InstancerMode get_instancer_mode() const { return _instancer ? _instancer->get_mode() : InstancerMode::NORMAL; }
 
+	// Navigation
+	void set_navigation_cache(const bool p_enabled);
+	bool get_navigation_cache() const { return _navigation_cache; }
+	void clear_nav_cache();
+
+	// Navigation Baking Aliases
+	void set_navigation_baking(const bool p_enabled) { _navigation ? _navigation->set_enabled(p_enabled) : void(); }
+	bool get_navigation_baking() const { return _navigation ? _navigation->is_enabled() : false; }
+	void set_navigation_template(const Ref<NavigationMesh> &p_template) { _navigation ? _navigation->set_template(p_template) : void(); }
+	Ref<NavigationMesh> get_navigation_template() const { return _navigation ? _navigation->get_template() : Ref<NavigationMesh>(); }
+	void set_navigation_tile_size(const real_t p_size) { _navigation ? _navigation->set_tile_size(p_size) : void(); }
+	real_t get_navigation_tile_size() const { return _navigation ? _navigation->get_tile_size() : 64.f; }
+	void set_navigation_radius(const real_t p_radius) { _navigation ? _navigation->set_radius(p_radius) : void(); }
+	real_t get_navigation_radius() const { return _navigation ? _navigation->get_radius() : 192.f; }
+	void set_navigation_layers(const uint32_t p_layers) { _navigation ? _navigation->set_layers(p_layers) : void(); }
+	uint32_t get_navigation_layers() const { return _navigation ? _navigation->get_layers() : 1; }
+	void set_navigation_require_nav(const bool p_require_nav) { _navigation ? _navigation->set_require_nav(p_require_nav) : void(); }
+	bool get_navigation_require_nav() const { return _navigation ? _navigation->get_require_nav() : true; }
+	void set_navigation_instances(const bool p_enabled) { _navigation ? _navigation->set_instances(p_enabled) : void(); }
+	bool get_navigation_instances() const { return _navigation ? _navigation->get_instances() : false; }
+
+	// Occlusion
+	void set_occlusion_enabled(const bool p_enabled);
+	bool is_occlusion_enabled() const { return _occlusion_enabled; }
+	void set_occlusion_triangle_budget(const int p_budget);
+	int get_occlusion_triangle_budget() const { return _occlusion_triangle_budget; }
+
 	// Utility
 	Vector3 get_intersection(const Vector3 &p_src_pos, const Vector3 &p_direction, const bool p_gpu_mode = false);
 	Dictionary get_raycast_result(const Vector3 &p_src_pos, const Vector3 &p_direction, const uint32_t p_col_mask = 0xFFFFFFFF, const bool p_exclude_self = false) const;
-	Ref<Mesh> bake_mesh(const int p_lod, const Terrain3DData::HeightFilter p_filter = Terrain3DData::HEIGHT_FILTER_NEAREST) const;
-	PackedVector3Array generate_nav_mesh_source_geometry(const AABB &p_global_aabb, const bool p_require_nav = true) const;
+	Ref<Mesh> bake_mesh(const int p_lod, const Terrain3DData::HeightFilter p_filter = Terrain3DData::HEIGHT_FILTER_NEAREST,
+			const real_t p_max_error = 0.f) const;
+	Dictionary bake_mesh_chunks(const int p_tile_size, const PackedInt32Array &p_lods,
+			const Terrain3DData::HeightFilter p_filter = Terrain3DData::HEIGHT_FILTER_NEAREST, const real_t p_skirt_depth = 0.f,
+			const String &p_save_dir = "") const;
+	PackedVector3Array generate_nav_mesh_source_geometry(const AABB &p_global_aabb, const bool p_require_nav = true,
+			const real_t p_max_error = 0.f, const bool p_instances = false) const;
+	Array generate_nav_mesh_source_arrays(const AABB &p_global_aabb, const bool p_require_nav = true,
+			const real_t p_max_error = 0.f, const bool p_instances = false) const;
 
 	// Warnings
 	void set_warning(const uint8_t p_warning, const bool p_enabled);
@@ -339,6 +495,8 @@ protected:
 
 VARIANT_ENUM_CAST(Terrain3D::RegionSize);
 VARIANT_ENUM_CAST(Terrain3D::DebugLevel);
+VARIANT_ENUM_CAST(Terrain3D::MeshMode);
+VARIANT_ENUM_CAST(Terrain3D::ClipmapUpdateMode);
 
 constexpr Terrain3D::DebugLevel MESG = Terrain3D::DebugLevel::MESG;
 constexpr Terrain3D::DebugLevel WARN = Terrain3D::DebugLevel::WARN;
@@ -156,41 +156,72 @@ Dictionary Terrain3DCollision::_get_shape_data(const Vector2i &p_position, const
 }
 
 void Terrain3DCollision::_shape_set_disabled(const int p_shape_id, const bool p_disabled) {
-	if (is_editor_mode()) {
-		CollisionShape3D *shape = _shapes[p_shape_id];
-		shape->set_disabled(p_disabled);
-		shape->set_visible(!p_disabled);
-	} else {
-		PS->body_set_shape_disabled(_static_body_rid, p_shape_id, p_disabled);
-	}
+	ShapeState &state = _shape_states[p_shape_id];
+	state.disabled = p_disabled;
+	state.dirty |= SHAPE_DIRTY_DISABLED;
 }
 
 void Terrain3DCollision::_shape_set_transform(const int p_shape_id, const Transform3D &p_xform) {
-	if (is_editor_mode()) {
-		CollisionShape3D *shape = _shapes[p_shape_id];
-		shape->set_transform(p_xform);
-	} else {
-		PS->body_set_shape_transform(_static_body_rid, p_shape_id, p_xform);
+	ShapeState &state = _shape_states[p_shape_id];
+	if (state.xform != p_xform) {
+		state.xform = p_xform;
+		state.dirty |= SHAPE_DIRTY_TRANSFORM;
 	}
 }
 
+// Shapes are children of a top level body at the origin, so their local position is global
 Vector3 Terrain3DCollision::_shape_get_position(const int p_shape_id) const {
-	if (is_editor_mode()) {
-		return _shapes[p_shape_id]->get_global_position();
-	} else {
-		return PS->body_get_shape_transform(_static_body_rid, p_shape_id).origin;
-	}
+	return _shape_states[p_shape_id].xform.origin;
 }
 
 void Terrain3DCollision::_shape_set_data(const int p_shape_id, const Dictionary &p_dict) {
-	if (is_editor_mode()) {
-		CollisionShape3D *shape = _shapes[p_shape_id];
-		Ref<HeightMapShape3D> hshape = shape->get_shape();
-		hshape->set_map_data(p_dict["heights"]);
-	} else {
-		RID shape_rid = PS->body_get_shape(_static_body_rid, p_shape_id);
-		PS->shape_set_data(shape_rid, p_dict);
+	ShapeState &state = _shape_states[p_shape_id];
+	state.data = p_dict;
+	state.dirty |= SHAPE_DIRTY_DATA;
+}
+
+// Sends the shape changes recorded since the last flush. Shapes disabled and reused in the same
+// update only send their final state.
+void Terrain3DCollision::_flush_shapes() {
+	int calls = 0;
+	for (int i = 0; i < int(_shape_states.size()); i++) {
+		ShapeState &state = _shape_states[i];
+		if (!state.dirty) {
+			continue;
+		}
+		const bool send_disabled = (state.dirty & SHAPE_DIRTY_DISABLED) && state.disabled != state.sent_disabled;
+		if (is_editor_mode()) {
+			CollisionShape3D *shape = _shapes[i];
+			if (state.dirty & SHAPE_DIRTY_TRANSFORM) {
+				shape->set_transform(state.xform);
+			}
+			if (state.dirty & SHAPE_DIRTY_DATA) {
+				Ref<HeightMapShape3D> hshape = shape->get_shape();
+				hshape->set_map_data(state.data["heights"]);
+			}
+			if (send_disabled) {
+				shape->set_disabled(state.disabled);
+				shape->set_visible(!state.disabled);
+			}
+		} else {
+			if (state.dirty & SHAPE_DIRTY_TRANSFORM) {
+				PS->body_set_shape_transform(_static_body_rid, i, state.xform);
+				calls++;
+			}
+			if (state.dirty & SHAPE_DIRTY_DATA) {
+				PS->shape_set_data(state.rid, state.data);
+				calls++;
+			}
+			if (send_disabled) {
+				PS->body_set_shape_disabled(_static_body_rid, i, state.disabled);
+				calls++;
+			}
+		}
+		state.sent_disabled = state.disabled;
+		state.data = Dictionary(); // Release the heights once sent
+		state.dirty = 0;
 	}
+	LOG(EXTREME, "Collision flush made ", calls, " PhysicsServer calls");
 }
 
 void Terrain3DCollision::_reload_physics_material() {
@@ -287,6 +318,7 @@ void Terrain3DCollision::build() {
 	if (is_editor_mode()) {
 		_shapes.reserve(shape_count);
 	}
+	_shape_states.assign(shape_count, ShapeState());
 	LOG(DEBUG, "Shape count: ", shape_count);
 	LOG(DEBUG, "Shape size: ", _shape_size, ", hshape_size: ", hshape_size);
 	Transform3D xform(Basis(), V3_MAX);
@@ -309,6 +341,7 @@ void Terrain3DCollision::build() {
 		} else {
 			RID shape_rid = PS->heightmap_shape_create();
 			PS->body_add_shape(_static_body_rid, shape_rid, xform, true);
+			_shape_states[i].rid = shape_rid;
 			LOG(DEBUG, "Adding shape: ", i, ", rid: ", shape_rid.get_id(), " pos: ", _shape_get_position(i));
 		}
 	}
@@ -362,7 +395,7 @@ void Terrain3DCollision::update(const Vector2i &p_region_loc, const bool p_rebui
 
 		real_t radius_sqr = real_t(_radius * _radius);
 		Vector2i shape_offset = V2I(_shape_size / 2); // offset meters to top left corner of shape
-		int shape_count = is_editor_mode() ? _shapes.size() : PS->body_get_shape_count(_static_body_rid);
+		int shape_count = int(_shape_states.size());
 		for (int i = 0; i < shape_count; i++) {
 			Vector3 shape_global_pos = _shape_get_position(i);
 			if (p_rebuild || shape_global_pos.x > 1e20f) {
@@ -458,6 +491,7 @@ void Terrain3DCollision::update(const Vector2i &p_region_loc, const bool p_rebui
 			_shape_set_data(i, shape_data);
 		}
 	}
+	_flush_shapes();
 	LOG(EXTREME, "Collision update time: ", Time::get_singleton()->get_ticks_usec() - time, " us");
 }
 
@@ -487,6 +521,7 @@ void Terrain3DCollision::destroy() {
 		memdelete_safely(shape);
 	}
 	_shapes.clear();
+	_shape_states.clear();
 	if (_static_body) {
 		LOG(DEBUG, "Freeing StaticBody3D");
 		remove_from_tree(_static_body);
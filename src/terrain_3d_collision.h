@@ -43,6 +43,23 @@ private:
 	StaticBody3D *_static_body = nullptr; // Editor mode StaticBody3D
 	std::vector<CollisionShape3D *> _shapes; // All CollisionShape3Ds
 
+	// Shape changes are recorded during update() and sent once at the end, so only the final state of
+	// each shape reaches the server. Reads come from here rather than the server.
+	enum ShapeDirty {
+		SHAPE_DIRTY_DISABLED = 1 << 0,
+		SHAPE_DIRTY_TRANSFORM = 1 << 1,
+		SHAPE_DIRTY_DATA = 1 << 2,
+	};
+	struct ShapeState {
+		RID rid; // Physics Server shape
+		Transform3D xform = Transform3D(Basis(), V3_MAX);
+		bool disabled = true;
+		Dictionary data;
+		uint8_t dirty = 0;
+		bool sent_disabled = true; // Disabled state the server has
+	};
+	std::vector<ShapeState> _shape_states;
+
 	bool _initialized = false;
 	Vector2i _last_snapped_pos = V2I_MAX;
 
@@ -54,6 +71,7 @@ private:
 	void _shape_set_transform(const int p_shape_id, const Transform3D &p_xform);
 	Vector3 _shape_get_position(const int p_shape_id) const;
 	void _shape_set_data(const int p_shape_id, const Dictionary &p_dict);
+	void _flush_shapes();
 
 	void _reload_physics_material();
 
@@ -5,7 +5,17 @@
 #include <godot_cpp/classes/editor_interface.hpp>
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/reg_ex.hpp>
+#include <godot_cpp/classes/reg_ex_match.hpp>
 #include <godot_cpp/classes/resource_saver.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
 
 #include "logger.h"
 #include "terrain_3d_data.h"
@@ -27,20 +37,155 @@ void Terrain3DData::_clear() {
 	_generated_color_maps.clear();
 }
 
-// Structured to work with do_for_regions. Should be renamed when copy_paste is expanded
-void Terrain3DData::_copy_paste_dfr(const Terrain3DRegion *p_src_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect, const Terrain3DRegion *p_dst_region) {
+// Copies the map data in p_src_rect of the source region to p_dst_rect of the destination region.
+// Structured to work with for_each_region. Rows are copied directly between matching formats, so it is
+// safe to call in parallel for different destination regions.
+void Terrain3DData::_copy_paste_dfr(const Terrain3DRegion *p_src_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect, Terrain3DRegion *p_dst_region) const {
 	if (!p_src_region || !p_dst_region) {
 		return;
 	}
-	TypedArray<Image> src_maps = p_src_region->get_maps();
-	TypedArray<Image> dst_maps = p_dst_region->get_maps();
-	for (int i = 0; i < dst_maps.size(); i++) {
-		Image *img = cast_to<Image>(dst_maps[i]);
-		if (img) {
-			img->blit_rect(src_maps[i], p_src_rect, p_dst_rect.position);
+	for (int i = 0; i < TYPE_MAX; i++) {
+		MapType map_type = static_cast<MapType>(i);
+		Image *src_map = p_src_region->get_map_ptr(map_type);
+		Image *dst_map = p_dst_region->get_map_ptr(map_type);
+		if (!src_map || !dst_map) {
+			continue;
+		}
+		if (src_map->get_format() != FORMAT[i] || dst_map->get_format() != FORMAT[i]) {
+			dst_map->blit_rect(Ref<Image>(src_map), p_src_rect, p_dst_rect.position);
+			continue;
+		}
+		// FORMAT_RF and FORMAT_RGBA8 are both 4 bytes per pixel. Mipmaps follow the first level.
+		const int64_t PIXEL_SIZE = 4;
+		const int64_t src_width = src_map->get_width();
+		const int64_t dst_width = dst_map->get_width();
+		const int64_t row_bytes = p_src_rect.size.x * PIXEL_SIZE;
+		const uint8_t *src_data = src_map->ptr();
+		uint8_t *dst_data = dst_map->ptrw();
+		for (int y = 0; y < p_src_rect.size.y; y++) {
+			int64_t src_offset = ((p_src_rect.position.y + y) * src_width + p_src_rect.position.x) * PIXEL_SIZE;
+			int64_t dst_offset = ((p_dst_rect.position.y + y) * dst_width + p_dst_rect.position.x) * PIXEL_SIZE;
+			memcpy(dst_data + dst_offset, src_data + src_offset, row_bytes);
 		}
 	}
-	_terrain->get_instancer()->copy_paste_dfr(p_src_region, p_src_rect, p_dst_region);
+}
+
+// Writes p_src_rect of a source image into a region map at p_dst_pos for import_images(), converting
+// formats on the fly rather than converting whole images first. Safe to call in parallel for different maps.
+// Height applies p_scale and p_offset, and replaces non-normal values with p_offset.
+void Terrain3DData::_import_rect(const MapType p_map_type, Image *p_src, const Rect2i &p_src_rect, Image *p_dst,
+		const Vector2i &p_dst_pos, const real_t p_offset, const real_t p_scale) const {
+	if (!p_src || !p_dst || p_dst->get_format() != FORMAT[p_map_type]) {
+		return;
+	}
+	const Image::Format src_format = p_src->get_format();
+	const int64_t src_width = p_src->get_width();
+	const int64_t dst_width = p_dst->get_width();
+	const int width = p_src_rect.size.x;
+
+	// Number of floats per pixel for float formats whose red channel can be read directly
+	int64_t float_stride = 0;
+	switch (src_format) {
+		case Image::FORMAT_RF:
+			float_stride = 1;
+			break;
+		case Image::FORMAT_RGF:
+			float_stride = 2;
+			break;
+		case Image::FORMAT_RGBF:
+			float_stride = 3;
+			break;
+		case Image::FORMAT_RGBAF:
+			float_stride = 4;
+			break;
+		default:
+			break;
+	}
+
+	switch (p_map_type) {
+		case TYPE_HEIGHT: {
+			float *dst_data = reinterpret_cast<float *>(p_dst->ptrw());
+			const float *src_data = float_stride > 0 ? reinterpret_cast<const float *>(p_src->ptr()) : nullptr;
+			std::vector<float> row;
+			if (!src_data) {
+				row.resize(width);
+			}
+			for (int y = 0; y < p_src_rect.size.y; y++) {
+				int src_y = p_src_rect.position.y + y;
+				float *dst_row = dst_data + (p_dst_pos.y + y) * dst_width + p_dst_pos.x;
+				if (src_data) {
+					const float *src_row = src_data + (src_y * src_width + p_src_rect.position.x) * float_stride;
+					scale_offset_heights(src_row, float_stride, dst_row, width, p_scale, p_offset);
+				} else {
+					for (int x = 0; x < width; x++) {
+						row[x] = p_src->get_pixel(p_src_rect.position.x + x, src_y).r;
+					}
+					scale_offset_heights(row.data(), 1, dst_row, width, p_scale, p_offset);
+				}
+			}
+		} break;
+
+		case TYPE_CONTROL: {
+			float *dst_data = reinterpret_cast<float *>(p_dst->ptrw());
+			const float *src_data = src_format == Image::FORMAT_RF ? reinterpret_cast<const float *>(p_src->ptr()) : nullptr;
+			for (int y = 0; y < p_src_rect.size.y; y++) {
+				int src_y = p_src_rect.position.y + y;
+				float *dst_row = dst_data + (p_dst_pos.y + y) * dst_width + p_dst_pos.x;
+				if (src_data) {
+					memcpy(dst_row, src_data + src_y * src_width + p_src_rect.position.x, width * sizeof(float));
+				} else {
+					for (int x = 0; x < width; x++) {
+						dst_row[x] = p_src->get_pixel(p_src_rect.position.x + x, src_y).r;
+					}
+				}
+			}
+		} break;
+
+		case TYPE_COLOR: {
+			if (src_format == Image::FORMAT_RGBA8) {
+				const int64_t PIXEL_SIZE = 4;
+				uint8_t *dst_data = p_dst->ptrw();
+				const uint8_t *src_data = p_src->ptr();
+				for (int y = 0; y < p_src_rect.size.y; y++) {
+					int64_t src_offset = ((p_src_rect.position.y + y) * src_width + p_src_rect.position.x) * PIXEL_SIZE;
+					int64_t dst_offset = ((p_dst_pos.y + y) * dst_width + p_dst_pos.x) * PIXEL_SIZE;
+					memcpy(dst_data + dst_offset, src_data + src_offset, width * PIXEL_SIZE);
+				}
+			} else {
+				for (int y = 0; y < p_src_rect.size.y; y++) {
+					for (int x = 0; x < width; x++) {
+						p_dst->set_pixel(p_dst_pos.x + x, p_dst_pos.y + y,
+								p_src->get_pixel(p_src_rect.position.x + x, p_src_rect.position.y + y));
+					}
+				}
+			}
+		} break;
+
+		default:
+			break;
+	}
+}
+
+// Returns the region at p_region_loc for importing, creating it or reviving a deleted one as needed,
+// with sanitized maps. Call from the main thread.
+Terrain3DRegion *Terrain3DData::_prepare_import_region(const Vector2i &p_region_loc) {
+	Ref<Terrain3DRegion> region = get_region(p_region_loc);
+	if (region.is_null()) {
+		region.instantiate();
+		region->set_location(p_region_loc);
+		region->set_region_size(_region_size);
+		region->set_vertex_spacing(_vertex_spacing);
+		if (add_region(region, false) != OK) {
+			return nullptr;
+		}
+	} else if (region->is_deleted()) {
+		region->clear();
+		region->set_location(p_region_loc);
+		region->set_region_size(_region_size);
+		region->set_vertex_spacing(_vertex_spacing);
+	}
+	region->sanitize_maps();
+	return region.ptr();
 }
 
 ///////////////////////////
@@ -85,31 +230,17 @@ TypedArray<Terrain3DRegion> Terrain3DData::get_regions_active(const bool p_copy,
 
 // Calls the callback function for every region within the given (descaled) area
 // The callable receives: source Terrain3DRegion, source Rect2i, dest Rect2i, (bindings)
-// Used with change_region_size, dest Terrain3DRegion is bound as the 4th parameter
+// Internally, use for_each_region() to avoid a Variant call per region
 void Terrain3DData::do_for_regions(const Rect2i &p_area, const Callable &p_callback) {
-	Rect2i location_bounds(V2I_DIVIDE_FLOOR(p_area.position, _region_size), V2I_DIVIDE_CEIL(p_area.size, _region_size));
-	LOG(DEBUG, "Processing global area: ", p_area, " -> ", location_bounds);
-	Point2i current_region_loc;
-	for (int y = location_bounds.position.y; y < location_bounds.get_end().y; y++) {
-		current_region_loc.y = y;
-		for (int x = location_bounds.position.x; x < location_bounds.get_end().x; x++) {
-			current_region_loc.x = x;
-			const Terrain3DRegion *region = get_region_ptr(current_region_loc);
-			if (region && !region->is_deleted()) {
-				LOG(DEBUG, "Current region: ", current_region_loc);
-				Rect2i region_area = p_area.intersection(Rect2i(current_region_loc * _region_size, _region_sizev));
-				LOG(DEBUG, "Region bounds: ", Rect2i(current_region_loc * _region_size, _region_sizev));
-				LOG(DEBUG, "Region area: ", region_area);
-				Rect2i dst_coords(region_area.position - p_area.position, region_area.size);
-				Rect2i src_coords(region_area.position - (region->get_location() * _region_sizev), dst_coords.size);
-				LOG(DEBUG, "src map coords: ", src_coords);
-				LOG(DEBUG, "dst map coords: ", dst_coords);
-				p_callback.call(region, src_coords, dst_coords);
-			}
-		}
-	}
+	LOG(DEBUG, "Processing global area: ", p_area);
+	for_each_region(p_area, [&](Terrain3DRegion *p_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect) {
+		LOG(DEBUG, "Current region: ", p_region->get_location(), ", src map coords: ", p_src_rect, ", dst map coords: ", p_dst_rect);
+		p_callback.call(p_region, p_src_rect, p_dst_rect);
+	});
 }
 
+// Reslices all regions into new regions of p_new_size. Each destination region is built in parallel
+// on the WorkerThreadPool by copying rows directly from the overlapping source region buffers.
 void Terrain3DData::change_region_size(int p_new_size) {
 	LOG(INFO, "Changing region size from: ", _region_size, " to ", p_new_size);
 	if (!is_valid_region_size(p_new_size)) {
@@ -119,6 +250,7 @@ void Terrain3DData::change_region_size(int p_new_size) {
 	if (p_new_size == _region_size) {
 		return;
 	}
+	uint64_t start_time = Time::get_singleton()->get_ticks_msec();
 
 	// Get current region corners expressed in new region_size coordinates
 	Dictionary new_region_locations;
@@ -136,8 +268,14 @@ void Terrain3DData::change_region_size(int p_new_size) {
 		}
 	}
 
-	// Make new regions to receive copied data
-	TypedArray<Terrain3DRegion> new_regions;
+	// Make new regions to receive copied data, and gather the current regions overlapping each
+	struct Source {
+		const Terrain3DRegion *region;
+		Rect2i src_rect;
+		Rect2i dst_rect;
+	};
+	std::vector<Ref<Terrain3DRegion>> new_regions;
+	std::vector<std::vector<Source>> new_region_sources;
 	Array new_locations = new_region_locations.keys();
 	for (const Vector2i &region_loc : new_locations) {
 		Ref<Terrain3DRegion> new_region;
@@ -146,34 +284,60 @@ void Terrain3DData::change_region_size(int p_new_size) {
 		new_region->set_region_size(p_new_size);
 		new_region->set_vertex_spacing(_vertex_spacing);
 		new_region->set_modified(true);
-		new_region->sanitize_maps();
-
-		// Copy current data from current into new region, up to new region size
-		Rect2i area;
-		area.position = region_loc * p_new_size;
-		area.size = V2I(p_new_size);
-		do_for_regions(area, callable_mp(this, &Terrain3DData::_copy_paste_dfr).bind(new_region.ptr()));
 		new_regions.push_back(new_region);
+
+		std::vector<Source> sources;
+		Rect2i area = Rect2i(region_loc * p_new_size, V2I(p_new_size));
+		for_each_region(area, [&](const Terrain3DRegion *p_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect) {
+			sources.push_back({ p_region, p_src_rect, p_dst_rect });
+		});
+		new_region_sources.push_back(sources);
+	}
+
+	// Copy current data into each new region in parallel. Each job only writes to its own region.
+	const int total = int(new_regions.size());
+	LOG(MESG, "Reslicing ", get_region_count(), " regions into ", total, " regions of size ", p_new_size);
+	std::atomic<int> completed(0);
+	parallel_for(total, [&](const int p_index) {
+		Terrain3DRegion *dst_region = new_regions[p_index].ptr();
+		for (int i = 0; i < TYPE_MAX; i++) {
+			dst_region->set_map(static_cast<MapType>(i), Util::get_filled_image(V2I(p_new_size), COLOR[i], false, FORMAT[i]));
+		}
+		for (const Source &source : new_region_sources[p_index]) {
+			_copy_paste_dfr(source.region, source.src_rect, source.dst_rect, dst_region);
+		}
+		dst_region->get_color_map()->generate_mipmaps();
+		dst_region->calc_height_range();
+		LOG(INFO, "Resliced region ", dst_region->get_location(), " (", ++completed, " / ", total, ")");
+	});
+
+	// Migrate instancer cells in bulk while the old regions are still held
+	Terrain3DInstancer *instancer = _terrain->get_instancer();
+	for (int i = 0; i < total; i++) {
+		for (const Source &source : new_region_sources[i]) {
+			instancer->copy_paste_dfr(source.region, source.src_rect, new_regions[i].ptr());
+		}
 	}
 
 	// Remove old data
-	_terrain->get_instancer()->destroy();
-	TypedArray<Terrain3DRegion> old_regions = get_regions_active();
-	for (const Ref<Terrain3DRegion> &region : old_regions) {
+	instancer->destroy();
+	TypedArray<Terrain3DRegion> old_regions_active = get_regions_active();
+	for (const Ref<Terrain3DRegion> &region : old_regions_active) {
 		remove_region(region, false);
 	}
 
 	// Change region size
 	_terrain->set_region_size((Terrain3D::RegionSize)p_new_size);
 
-	// Add new regions and rebuild
+	// Add new regions and rebuild. Height ranges and color mipmaps were generated above.
 	for (const Ref<Terrain3DRegion> &region : new_regions) {
 		add_region(region, false);
 	}
 
-	calc_height_range(true);
-	update_maps(TYPE_MAX, true, true);
-	_terrain->get_instancer()->update_mmis(-1, V2I_MAX, true);
+	calc_height_range();
+	update_maps(TYPE_MAX, true, false);
+	instancer->update_mmis(-1, V2I_MAX, true);
+	LOG(MESG, "Changed region size to ", p_new_size, " in ", Time::get_singleton()->get_ticks_msec() - start_time, "ms");
 }
 
 void Terrain3DData::set_region_modified(const Vector2i &p_region_loc, const bool p_modified) {
@@ -454,6 +618,16 @@ void Terrain3DData::update_maps(const MapType p_map_type, const bool p_all_regio
 		}
 	}
 
+	// Mark region minimum heights for rebuilding on next use
+	if (p_map_type != TYPE_COLOR) {
+		for (const Vector2i &region_loc : _regions.keys()) {
+			Terrain3DRegion *region = get_region_ptr(region_loc);
+			if (region && (p_all_regions || region->is_edited())) {
+				region->mark_min_heights_dirty();
+			}
+		}
+	}
+
 	// Mark texture arrays dirty for rebuilding
 	if (p_all_regions) {
 		LOG(EXTREME, "Marking dirty maps of type: ", p_map_type);
@@ -623,6 +797,9 @@ void Terrain3DData::set_pixel(const MapType p_map_type, const Vector3 &p_global_
 	if (map) {
 		map->set_pixelv(img_pos, p_pixel);
 		region->set_modified(true);
+		if (p_map_type != TYPE_COLOR) {
+			region->mark_min_heights_dirty();
+		}
 	}
 }
 
@@ -651,6 +828,137 @@ Color Terrain3DData::get_pixel(const MapType p_map_type, const Vector3 &p_global
 	}
 }
 
+/**
+ * Copies the raw 32-bit values of the height or control map over a descaled area into r_dst, which must hold
+ * p_area.size.x * p_area.size.y floats, in rows. Pixels outside of active regions are filled with NAN for
+ * height, and UINT32_MAX for control, matching get_pixel() and get_control(). Reads only, so it can be used
+ * from worker threads while the maps aren't being edited.
+ */
+void Terrain3DData::read_map_rect(const MapType p_map_type, const Rect2i &p_area, float *r_dst) const {
+	ERR_FAIL_COND(p_map_type != TYPE_HEIGHT && p_map_type != TYPE_CONTROL);
+	ERR_FAIL_COND(!r_dst || !p_area.has_area());
+	const float fill = (p_map_type == TYPE_HEIGHT) ? NAN : as_float(UINT32_MAX);
+	const int64_t width = p_area.size.x;
+	std::fill(r_dst, r_dst + width * p_area.size.y, fill);
+	for_each_region(p_area, [&](const Terrain3DRegion *p_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect) {
+		const Image *map = p_region->get_map_ptr(p_map_type);
+		if (!map || map->get_format() != FORMAT[p_map_type]) {
+			return;
+		}
+		const float *src = reinterpret_cast<const float *>(map->ptr());
+		for (int y = 0; y < p_src_rect.size.y; y++) {
+			memcpy(r_dst + (p_dst_rect.position.y + y) * width + p_dst_rect.position.x,
+					src + int64_t(p_src_rect.position.y + y) * _region_size + p_src_rect.position.x,
+					p_src_rect.size.x * sizeof(float));
+		}
+	});
+}
+
+// Copies minimum heights from level p_level of each region's pyramid into r_dst, row major. p_blocks is in
+// global block coordinates, where each block covers (1 << p_level) descaled pixels on a side. Blocks
+// outside of regions are NAN. Level 0 is read from the height and control maps.
+void Terrain3DData::read_min_height_rect(const int p_level, const Rect2i &p_blocks, float *r_dst) const {
+	ERR_FAIL_COND(!r_dst || !p_blocks.has_area());
+	ERR_FAIL_COND(p_level < 0 || (1 << p_level) > _region_size);
+	const int block = 1 << p_level;
+	const int level_size = _region_size / block;
+	const int64_t width = p_blocks.size.x;
+	std::fill(r_dst, r_dst + width * p_blocks.size.y, float(NAN));
+	const Rect2i area = Rect2i(p_blocks.position * block, p_blocks.size * block);
+	for_each_region(area, [&](Terrain3DRegion *p_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect) {
+		const std::shared_ptr<const Terrain3DRegion::HeightPyramids> pyramids = p_region->get_height_pyramids();
+		if (!pyramids) {
+			return;
+		}
+		// Region edges are multiples of the block size, so these divide evenly
+		const Vector2i src_pos = p_src_rect.position / block;
+		const Vector2i dst_pos = p_dst_rect.position / block;
+		const Vector2i size = p_src_rect.size / block;
+		if (p_level == 0) {
+			const float *heights = reinterpret_cast<const float *>(p_region->get_map_ptr(TYPE_HEIGHT)->ptr());
+			const float *controls = reinterpret_cast<const float *>(p_region->get_map_ptr(TYPE_CONTROL)->ptr());
+			for (int y = 0; y < size.y; y++) {
+				float *dst = r_dst + (dst_pos.y + y) * width + dst_pos.x;
+				const int64_t src_row = int64_t(src_pos.y + y) * level_size + src_pos.x;
+				for (int x = 0; x < size.x; x++) {
+					dst[x] = is_hole(controls[src_row + x]) ? NAN : heights[src_row + x];
+				}
+			}
+			return;
+		}
+		const float *src = pyramids->get_min_heights(p_level);
+		if (!src) {
+			return;
+		}
+		for (int y = 0; y < size.y; y++) {
+			memcpy(r_dst + (dst_pos.y + y) * width + dst_pos.x,
+					src + int64_t(src_pos.y + y) * level_size + src_pos.x,
+					size.x * sizeof(float));
+		}
+	});
+}
+
+// Returns the lowest height within the descaled area, or NAN if it includes a hole or no region.
+// Reads the coarsest pyramid level whose blocks are aligned to both corners of the area, so the result is
+// exact. For areas aligned to their size, eg. the windows of get_mesh_vertex(), that is only a few blocks.
+real_t Terrain3DData::get_min_height(const Rect2i &p_area) const {
+	ERR_FAIL_COND_V(!p_area.has_area(), NAN);
+	const int extent = MIN(p_area.size.x, p_area.size.y);
+	const Vector2i area_end = p_area.get_end();
+	const int32_t corners = p_area.position.x | p_area.position.y | area_end.x | area_end.y;
+	int level = 0;
+	while ((2 << level) <= extent && (2 << level) <= _region_size && (corners & ((2 << level) - 1)) == 0) {
+		level++;
+	}
+	const int block = 1 << level;
+	const Vector2i start = V2I_DIVIDE_FLOOR(p_area.position, block);
+	const Vector2i end = V2I_DIVIDE_CEIL(area_end, block);
+	const Rect2i blocks = Rect2i(start, end - start);
+	std::vector<float> mins(blocks.get_area());
+	read_min_height_rect(level, blocks, mins.data());
+	real_t height = FLT_MAX;
+	for (const float h : mins) {
+		if (std::isnan(h)) {
+			return NAN;
+		}
+		height = MIN(height, h);
+	}
+	return height;
+}
+
+// Returns the lowest and highest heights within the descaled area, ignoring holes, or NAN if it has no
+// heights. The enclosing blocks of a coarse pyramid level are read, so the bounds may be a little wider
+// than the area's. Meant for culling, where that is conservative.
+Vector2 Terrain3DData::get_height_bounds(const Rect2i &p_area) const {
+	ERR_FAIL_COND_V(!p_area.has_area(), V2(NAN));
+	const int extent = MIN(p_area.size.x, p_area.size.y);
+	int level = Terrain3DRegion::HEIGHT_BOUNDS_LEVEL;
+	while ((2 << level) <= extent && (2 << level) <= _region_size) {
+		level++;
+	}
+	const int block = 1 << level;
+	const int level_size = _region_size / block;
+	Vector2 bounds = V2(NAN);
+	for_each_region(p_area, [&](Terrain3DRegion *p_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect) {
+		const std::shared_ptr<const Terrain3DRegion::HeightPyramids> pyramids = p_region->get_height_pyramids();
+		const Vector2 *src = pyramids ? pyramids->get_height_bounds(level) : nullptr;
+		if (!src) {
+			return;
+		}
+		const Vector2i src_end = p_src_rect.get_end();
+		const Vector2i start = V2I_DIVIDE_FLOOR(p_src_rect.position, block);
+		const Vector2i end = V2I_DIVIDE_CEIL(src_end, block);
+		for (int y = start.y; y < end.y; y++) {
+			for (int x = start.x; x < end.x; x++) {
+				const Vector2 &b = src[int64_t(y) * level_size + x];
+				bounds.x = std::fmin(bounds.x, b.x);
+				bounds.y = std::fmax(bounds.y, b.y);
+			}
+		}
+	});
+	return bounds;
+}
+
 real_t Terrain3DData::get_height(const Vector3 &p_global_position) const {
 	if (is_hole(get_control(p_global_position))) {
 		return NAN;
@@ -784,7 +1092,7 @@ Vector3 Terrain3DData::get_texture_id(const Vector3 &p_global_position) const {
  * p_global_position: X and Z coordinates of the vertex. Heights will be sampled around these coordinates.
  */
 Vector3 Terrain3DData::get_mesh_vertex(const int32_t p_lod, const HeightFilter p_filter, const Vector3 &p_global_position) const {
-	LOG(INFO, "Calculating vertex location");
+	LOG(EXTREME, "Calculating vertex location");
 	int32_t step = 1 << CLAMP(p_lod, 0, 8);
 	real_t height = 0.0f;
 
@@ -797,20 +1105,15 @@ Vector3 Terrain3DData::get_mesh_vertex(const int32_t p_lod, const HeightFilter p
 			}
 		} break;
 		case HEIGHT_FILTER_MINIMUM: {
-			height = get_height(p_global_position);
-			for (int32_t dx = -step / 2; dx < step / 2; dx += 1) {
-				for (int32_t dz = -step / 2; dz < step / 2; dz += 1) {
-					Vector3 position = p_global_position + Vector3(dx, 0.f, dz) * _vertex_spacing;
-					if (is_hole(get_control(position))) {
-						height = NAN;
-						break;
-					}
-					real_t h = get_height(position);
-					if (h < height) {
-						height = h;
-					}
-				}
+			if (step == 1) {
+				height = is_hole(get_control(p_global_position)) ? NAN : get_height(p_global_position);
+				break;
 			}
+			// Lowest height in the step sized window centered on the vertex, read from the region pyramids in
+			// blocks of half a step, as in Terrain3D::_generate_grid()
+			const Vector3 descaled_pos = p_global_position / _vertex_spacing;
+			const Vector2i pos = Vector2i(Math::round(descaled_pos.x), Math::round(descaled_pos.z));
+			height = get_min_height(Rect2i(pos - V2I(step / 2), V2I(step)));
 		} break;
 	}
 	return Vector3(p_global_position.x, height, p_global_position.z);
@@ -827,17 +1130,23 @@ void Terrain3DData::add_edited_area(const AABB &p_area) {
 }
 
 // Recalculates master height range from all active regions current height ranges
-// Recursive mode has all regions to recalculate from each heightmap pixel
+// Recursive mode has all regions to recalculate from each heightmap pixel, in parallel
 void Terrain3DData::calc_height_range(const bool p_recursive) {
 	_master_height_range = V2_ZERO;
+	std::vector<Terrain3DRegion *> regions;
+	regions.reserve(_region_locations.size());
 	for (const Vector2i &region_loc : _region_locations) {
 		Terrain3DRegion *region = get_region_ptr(region_loc);
-		if (!region) {
-			continue;
-		}
-		if (p_recursive) {
-			region->calc_height_range();
+		if (region) {
+			regions.push_back(region);
 		}
+	}
+	if (p_recursive) {
+		parallel_for(int(regions.size()), [&](const int p_index) {
+			regions[p_index]->calc_height_range();
+		});
+	}
+	for (const Terrain3DRegion *region : regions) {
 		update_master_heights(region->get_height_range());
 	}
 	LOG(EXTREME, "Accumulated height range for all regions: ", _master_height_range);
@@ -893,33 +1202,22 @@ void Terrain3DData::import_images(const TypedArray<Image> &p_images, const Vecto
 		return;
 	}
 
-	TypedArray<Image> src_images;
-	src_images.resize(TYPE_MAX);
-
+	// Compressed images can't be read directly, so decompress a copy. Other formats are read in place.
+	std::vector<Ref<Image>> src_images(TYPE_MAX);
 	for (int i = 0; i < TYPE_MAX; i++) {
 		Ref<Image> img = p_images[i];
-		src_images[i] = img;
-		if (img.is_null()) {
+		if (img.is_null() || img->is_empty()) {
 			continue;
 		}
-
-		// Apply scale and offsets to the heightmap and filter out invalid data
-		if (i == TYPE_HEIGHT) {
-			LOG(DEBUG, "Creating new temp image to adjust scale: ", p_scale, " offset: ", p_offset);
-			Ref<Image> newimg = Image::create_empty(img->get_size().x, img->get_size().y, false, FORMAT[TYPE_HEIGHT]);
-			for (int y = 0; y < img->get_height(); y++) {
-				for (int x = 0; x < img->get_width(); x++) {
-					Color clr = img->get_pixel(x, y);
-					if (std::isnormal(clr.r)) {
-						clr.r = (clr.r * p_scale) + p_offset;
-					} else {
-						clr.r = p_offset;
-					}
-					newimg->set_pixel(x, y, clr);
-				}
-			}
-			src_images[i] = newimg;
+		if (img->is_compressed()) {
+			LOG(DEBUG, "Decompressing a copy of image type ", TYPESTR[i]);
+			Ref<Image> decompressed;
+			decompressed.instantiate();
+			decompressed->copy_from(img);
+			decompressed->decompress();
+			img = decompressed;
 		}
+		src_images[i] = img;
 	}
 
 	// Calculate regions this image will span
@@ -942,77 +1240,227 @@ void Terrain3DData::import_images(const TypedArray<Image> &p_images, const Vecto
 
 	LOG(DEBUG, "Image spans regions (", start_region_x, ",", start_region_z, ") to (", end_region_x, ",", end_region_z, ")");
 
-	bool generate_mipmaps = false;
+	// Create or reset regions on this thread so the maps exist in the expected formats
 	for (int rz = start_region_z; rz <= end_region_z; rz++) {
 		for (int rx = start_region_x; rx <= end_region_x; rx++) {
-			Vector2i region_loc = Vector2i(rx, rz);
+			_prepare_import_region(Vector2i(rx, rz));
+		}
+	}
+
+	// Transform and copy source rows directly into each overlapping region's maps, in parallel
+	Rect2i img_area = Rect2i(img_start_x, img_start_z, img_size.x, img_size.y);
+	for_each_region_parallel(img_area, [&](Terrain3DRegion *p_region, const Rect2i &p_region_rect, const Rect2i &p_image_rect) {
+		for (int i = 0; i < TYPE_MAX; i++) {
+			const Ref<Image> &img = src_images[i];
+			if (img.is_null()) {
+				continue;
+			}
+			Image *dst_map = p_region->get_map_ptr(static_cast<MapType>(i));
+			_import_rect(static_cast<MapType>(i), img.ptr(), p_image_rect, dst_map, p_region_rect.position, p_offset, p_scale);
+			if (i == TYPE_HEIGHT) {
+				p_region->calc_height_range();
+			} else if (i == TYPE_COLOR) {
+				dst_map->generate_mipmaps();
+			}
+		}
+		p_region->set_modified(true);
+	});
+	update_maps(TYPE_MAX, true, false);
+}
 
-			int region_start_x = rx * _region_size;
-			int region_start_z = rz * _region_size;
-			int region_end_x = region_start_x + _region_size - 1;
-			int region_end_z = region_start_z + _region_size - 1;
+/**
+ * Imports a directory of tiled heightmaps, such as those exported from GIS software, into Terrain3DData
+ * Tiles are loaded and written to regions in batches on the WorkerThreadPool, so only p_max_concurrent
+ * tiles are held in memory at once. region_imported is emitted as each region receives all of its tiles.
+ * Parameters:
+ *	p_dir - Directory containing the tiles
+ *	p_pattern - File name pattern with {x} and {y} in place of the tile grid coordinates, eg. "tile_{x}_{y}.exr"
+ *	p_grid_origin - Tile grid coordinates placed at p_global_position
+ *	p_global_position - X,0,Z location of the top left corner of the p_grid_origin tile
+ *	p_offset, p_scale - Applied to all heights as in import_images()
+ *	p_r16_height_range, p_r16_size - Used for R16 tiles. See Terrain3DUtil::load_image()
+ *	p_max_concurrent - Maximum number of tiles loaded at once. 0 uses the processor count
+ *	p_overlap - Pixels each tile shares with its right and bottom neighbors, eg. 1 for GIS tiles of 2^n+1.
+ *		Tiles are placed every tile size - p_overlap pixels, and shared pixels are written by both tiles
+ */
+Error Terrain3DData::import_tiles(const String &p_dir, const String &p_pattern, const Vector2i &p_grid_origin,
+		const Vector3 &p_global_position, const real_t p_offset, const real_t p_scale,
+		const Vector2 &p_r16_height_range, const Vector2i &p_r16_size, const int p_max_concurrent, const int p_overlap) {
+	IS_INIT_MESG("Data not initialized", FAILED);
+	if (!p_pattern.contains("{x}") || !p_pattern.contains("{y}")) {
+		LOG(ERROR, "Tile pattern '", p_pattern, "' must contain {x} and {y}");
+		return ERR_INVALID_PARAMETER;
+	}
+	uint64_t start_time = Time::get_singleton()->get_ticks_msec();
+
+	// Convert the pattern to a regular expression capturing the grid coordinates
+	String regex_str = "(?i)^";
+	static const String special_chars = ".^$*+?()[]{}|\\";
+	for (int i = 0; i < p_pattern.length(); i++) {
+		if (p_pattern.substr(i, 3) == "{x}") {
+			regex_str += "(?<x>-?\\d+)";
+			i += 2;
+		} else if (p_pattern.substr(i, 3) == "{y}") {
+			regex_str += "(?<y>-?\\d+)";
+			i += 2;
+		} else {
+			String c = p_pattern.substr(i, 1);
+			regex_str += special_chars.contains(c) ? "\\" + c : c;
+		}
+	}
+	regex_str += "$";
+	Ref<RegEx> regex = RegEx::create_from_string(regex_str);
+	if (regex.is_null() || !regex->is_valid()) {
+		LOG(ERROR, "Cannot parse tile pattern: ", p_pattern);
+		return ERR_INVALID_PARAMETER;
+	}
+
+	struct Tile {
+		String path;
+		Vector2i grid;
+		Rect2i area; // Descaled global area
+		Ref<Image> image;
+	};
+	std::vector<Tile> tiles;
+	PackedStringArray files = Util::get_files(p_dir);
+	for (const String &fname : files) {
+		Ref<RegExMatch> match = regex->search(fname);
+		if (match.is_null()) {
+			continue;
+		}
+		Tile tile;
+		tile.path = p_dir.path_join(fname);
+		tile.grid = Vector2i(match->get_string("x").to_int(), match->get_string("y").to_int());
+		tiles.push_back(tile);
+	}
+	if (tiles.empty()) {
+		LOG(ERROR, "No tiles matching '", p_pattern, "' found in: ", p_dir);
+		return ERR_FILE_NOT_FOUND;
+	}
 
-			int overlap_start_x = MAX(region_start_x, img_start_x);
-			int overlap_start_z = MAX(region_start_z, img_start_z);
-			int overlap_end_x = MIN(region_end_x, img_end_x);
-			int overlap_end_z = MIN(region_end_z, img_end_z);
+	// Load the first tile to get the tile size, which all tiles must share
+	tiles[0].image = Util::load_image(tiles[0].path, ResourceLoader::CACHE_MODE_IGNORE, p_r16_height_range, p_r16_size);
+	if (tiles[0].image.is_null()) {
+		return ERR_FILE_CORRUPT;
+	}
+	const Vector2i tile_size = tiles[0].image->get_size();
+	if (p_overlap < 0 || p_overlap >= MIN(tile_size.x, tile_size.y)) {
+		LOG(ERROR, "Tile overlap ", p_overlap, " must be at least 0 and less than the tile size ", tile_size);
+		return ERR_INVALID_PARAMETER;
+	}
+	if (p_overlap == 0 && is_power_of_2(tile_size.x - 1) && is_power_of_2(tile_size.y - 1)) {
+		LOG(WARN, "Tiles sized ", tile_size, " usually share their edges with neighbors. If so, set overlap to 1");
+	}
+	// Tiles are placed by this step, so overlapping pixels are written by each neighbor
+	const Vector2i tile_step = tile_size - V2I(p_overlap);
+	LOG(MESG, "Importing ", int(tiles.size()), " tiles sized ", tile_size, " with overlap ", p_overlap, " from ", p_dir);
 
-			// Skip if no overlap
-			if (overlap_end_x < overlap_start_x || overlap_end_z < overlap_start_z) {
-				continue;
+	// Place tiles and count how many tiles cover each region
+	Vector2i origin = v3v2i(p_global_position / _vertex_spacing);
+	int max_dimension = _region_size * REGION_MAP_SIZE / 2;
+	Rect2i world_area = Rect2i(V2I(-max_dimension), V2I(max_dimension * 2));
+	std::unordered_map<Vector2i, int, Vector2iHash> tiles_remaining;
+	for (int i = int(tiles.size()) - 1; i >= 0; i--) {
+		Tile &tile = tiles[i];
+		tile.area = Rect2i(origin + (tile.grid - p_grid_origin) * tile_step, tile_size);
+		if (!world_area.encloses(tile.area)) {
+			LOG(ERROR, "Tile ", tile.path, " at ", tile.area.position, " is outside of the world. Skipping");
+			tiles.erase(tiles.begin() + i);
+			continue;
+		}
+		for_each_region_location(tile.area, [&](const Vector2i &p_region_loc) {
+			tiles_remaining[p_region_loc]++;
+		});
+	}
+
+	int batch_size = (p_max_concurrent > 0) ? p_max_concurrent : OS::get_singleton()->get_processor_count();
+	int processed_regions = 0;
+	for (int batch_start = 0; batch_start < int(tiles.size()); batch_start += batch_size) {
+		const int batch_count = MIN(batch_size, int(tiles.size()) - batch_start);
+
+		// Load this batch of tiles in parallel
+		parallel_for(batch_count, [&](const int p_index) {
+			Tile &tile = tiles[batch_start + p_index];
+			if (tile.image.is_null()) {
+				tile.image = Util::load_image(tile.path, ResourceLoader::CACHE_MODE_IGNORE, p_r16_height_range, p_r16_size);
 			}
+		});
 
-			int copy_width = overlap_end_x - overlap_start_x + 1;
-			int copy_height = overlap_end_z - overlap_start_z + 1;
-
-			int src_x = overlap_start_x - img_start_x;
-			int src_z = overlap_start_z - img_start_z;
-			int dst_x = overlap_start_x - region_start_x;
-			int dst_z = overlap_start_z - region_start_z;
-
-			LOG(DEBUG, "Region ", region_loc, ": copying ", Vector2i(copy_width, copy_height),
-					" from img(", src_x, ",", src_z, ") to region(", dst_x, ",", dst_z, ")");
-
-			Ref<Terrain3DRegion> region = get_region(region_loc);
-			if (region.is_null()) {
-				region.instantiate();
-				region->set_location(region_loc);
-				region->set_region_size(_region_size);
-				region->set_vertex_spacing(_vertex_spacing);
-				add_region(region, false);
-			} else if (region->is_deleted()) {
-				region->clear();
-				region->set_location(region_loc);
-				region->set_region_size(_region_size);
-				region->set_vertex_spacing(_vertex_spacing);
+		// Prepare regions on this thread, and gather the pieces of each tile by destination region
+		struct Piece {
+			Image *image;
+			Rect2i image_rect;
+			Vector2i region_pos;
+		};
+		std::unordered_map<Vector2i, std::vector<Piece>, Vector2iHash> region_pieces;
+		for (int i = batch_start; i < batch_start + batch_count; i++) {
+			Tile &tile = tiles[i];
+			bool valid = tile.image.is_valid() && tile.image->get_size() == tile_size;
+			if (tile.image.is_valid() && !valid) {
+				LOG(ERROR, "Tile ", tile.path, " size ", tile.image->get_size(), " doesn't match ", tile_size, ". Skipping");
 			}
-			for (int i = 0; i < TYPE_MAX; i++) {
-				Ref<Image> img = src_images[i];
-				if (img.is_valid() && !img->is_empty()) {
-					Ref<Image> region_map;
-
-					Ref<Image> existing_map = region->get_map(static_cast<MapType>(i));
-					if (existing_map.is_valid() && !existing_map->is_empty()) {
-						region_map.instantiate();
-						region_map->copy_from(existing_map);
-						if (region_map->get_format() != img->get_format()) {
-							region_map->convert(img->get_format());
-						}
-					} else {
-						region_map = Util::get_filled_image(_region_sizev, COLOR[i], false, img->get_format());
-					}
-					region_map->blit_rect(img, Rect2i(src_x, src_z, copy_width, copy_height), Vector2i(dst_x, dst_z));
-					region->set_map(static_cast<MapType>(i), region_map);
-					if (i == TYPE_COLOR) {
-						generate_mipmaps = true;
-					}
+			if (valid && tile.image->is_compressed()) {
+				tile.image->decompress();
+			}
+			for_each_region_location(tile.area, [&](const Vector2i &p_region_loc) {
+				// Failed tiles still count towards completing their regions
+				tiles_remaining[p_region_loc]--;
+				std::vector<Piece> &pieces = region_pieces[p_region_loc];
+				if (!valid || !_prepare_import_region(p_region_loc)) {
+					return;
 				}
+				Rect2i region_area = Rect2i(p_region_loc * _region_size, _region_sizev);
+				Rect2i overlap = tile.area.intersection(region_area);
+				pieces.push_back({ tile.image.ptr(), Rect2i(overlap.position - tile.area.position, overlap.size),
+						overlap.position - region_area.position });
+			});
+		}
+
+		// Write pieces in parallel by region, so each job owns its height map, including overlapping pixels
+		std::vector<Vector2i> batch_regions;
+		for (const auto &pair : region_pieces) {
+			batch_regions.push_back(pair.first);
+		}
+		parallel_for(int(batch_regions.size()), [&](const int p_index) {
+			const std::vector<Piece> &pieces = region_pieces.at(batch_regions[p_index]);
+			Terrain3DRegion *region = pieces.empty() ? nullptr : get_region_ptr(batch_regions[p_index]);
+			if (!region) {
+				return;
+			}
+			for (const Piece &piece : pieces) {
+				_import_rect(TYPE_HEIGHT, piece.image, piece.image_rect, region->get_map_ptr(TYPE_HEIGHT),
+						piece.region_pos, p_offset, p_scale);
 			}
 			region->set_modified(true);
-			region->sanitize_maps();
+		});
+
+		// Finish regions that have received all of their tiles
+		std::vector<Vector2i> finished;
+		for (const Vector2i &region_loc : batch_regions) {
+			if (tiles_remaining[region_loc] <= 0 && get_region_ptr(region_loc)) {
+				finished.push_back(region_loc);
+			}
 		}
+		parallel_for(int(finished.size()), [&](const int p_index) {
+			get_region_ptr(finished[p_index])->calc_height_range();
+		});
+		for (const Vector2i &region_loc : finished) {
+			emit_signal("region_imported", region_loc);
+		}
+		processed_regions += int(finished.size());
+
+		// Release this batch
+		for (int i = batch_start; i < batch_start + batch_count; i++) {
+			tiles[i].image.unref();
+		}
+		LOG(INFO, "Imported tiles ", batch_start + batch_count, "/", int(tiles.size()));
 	}
-	update_maps(TYPE_MAX, true, generate_mipmaps);
+
+	calc_height_range();
+	update_maps(TYPE_MAX, true, false);
+	LOG(MESG, "Imported ", int(tiles.size()), " tiles into ", processed_regions, " regions in ",
+			Time::get_singleton()->get_ticks_msec() - start_time, "ms");
+	return OK;
 }
 
 /** Exports a specified map as one of r16/raw, exr, jpg, png, webp, res, tres
@@ -1081,7 +1529,7 @@ Error Terrain3DData::export_image(const String &p_file_name, const MapType p_map
 	String ext = file_name.get_extension().to_lower();
 	LOG(MESG, "Saving ", img->get_size(), " sized ", TYPESTR[p_map_type],
 			" map in format ", img->get_format(), " as ", ext, " to: ", file_name);
-	Vector2i minmax = Util::get_min_max(img);
+	Vector2 minmax = Util::get_min_max(img);
 	LOG(MESG, "Minimum height: ", minmax.x, ", Maximum height: ", minmax.y);
 	if (ext == "r16" || ext == "raw") {
 		Ref<FileAccess> file = FileAccess::open(file_name, FileAccess::WRITE);
@@ -1270,6 +1718,7 @@ void Terrain3DData::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("calc_height_range", "recursive"), &Terrain3DData::calc_height_range, DEFVAL(false));
 
 	ClassDB::bind_method(D_METHOD("import_images", "images", "global_position", "offset", "scale"), &Terrain3DData::import_images, DEFVAL(V3_ZERO), DEFVAL(0.f), DEFVAL(1.f));
+	ClassDB::bind_method(D_METHOD("import_tiles", "directory", "pattern", "grid_origin", "global_position", "offset", "scale", "r16_height_range", "r16_size", "max_concurrent", "overlap"), &Terrain3DData::import_tiles, DEFVAL(V2I_ZERO), DEFVAL(V3_ZERO), DEFVAL(0.f), DEFVAL(1.f), DEFVAL(Vector2(0.f, 255.f)), DEFVAL(V2I_ZERO), DEFVAL(0), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("export_image", "file_name", "map_type"), &Terrain3DData::export_image);
 	ClassDB::bind_method(D_METHOD("layered_to_image", "map_type"), &Terrain3DData::layered_to_image);
 	ClassDB::bind_method(D_METHOD("dump", "verbose"), &Terrain3DData::dump, DEFVAL(false));
@@ -1286,4 +1735,5 @@ void Terrain3DData::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("control_maps_changed"));
 	ADD_SIGNAL(MethodInfo("color_maps_changed"));
 	ADD_SIGNAL(MethodInfo("maps_edited", PropertyInfo(Variant::AABB, "edited_area")));
+	ADD_SIGNAL(MethodInfo("region_imported", PropertyInfo(Variant::VECTOR2I, "region_location")));
 }
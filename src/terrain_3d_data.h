@@ -3,6 +3,8 @@
 #ifndef TERRAIN3D_DATA_CLASS_H
 #define TERRAIN3D_DATA_CLASS_H
 
+#include <vector>
+
 #include "constants.h"
 #include "generated_texture.h"
 #include "terrain_3d_region.h"
@@ -13,6 +15,7 @@ class Terrain3DData : public Object {
 	GDCLASS(Terrain3DData, Object);
 	CLASS_NAME();
 	friend Terrain3D;
+	friend void test_get_mesh_vertex();
 
 public: // Constants
 	static inline const real_t CURRENT_DATA_VERSION = 0.93f; // Current Data format version
@@ -75,7 +78,10 @@ private:
 
 	// Functions
 	void _clear();
-	void _copy_paste_dfr(const Terrain3DRegion *p_src_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect, const Terrain3DRegion *p_dst_region);
+	void _copy_paste_dfr(const Terrain3DRegion *p_src_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect, Terrain3DRegion *p_dst_region) const;
+	Terrain3DRegion *_prepare_import_region(const Vector2i &p_region_loc);
+	void _import_rect(const MapType p_map_type, Image *p_src, const Rect2i &p_src_rect, Image *p_dst,
+			const Vector2i &p_dst_pos, const real_t p_offset, const real_t p_scale) const;
 
 public:
 	Terrain3DData() {}
@@ -92,6 +98,12 @@ public:
 	PackedInt32Array get_region_map() const { return _region_map; }
 	static int get_region_map_index(const Vector2i &p_region_loc);
 
+	template <typename F>
+	void for_each_region_location(const Rect2i &p_area, const F &p_func) const;
+	template <typename F>
+	void for_each_region(const Rect2i &p_area, const F &p_func) const;
+	template <typename F>
+	void for_each_region_parallel(const Rect2i &p_area, const F &p_func) const;
 	void do_for_regions(const Rect2i &p_area, const Callable &p_callback);
 	void change_region_size(int region_size);
 
@@ -137,6 +149,10 @@ public:
 
 	void set_pixel(const MapType p_map_type, const Vector3 &p_global_position, const Color &p_pixel);
 	Color get_pixel(const MapType p_map_type, const Vector3 &p_global_position) const;
+	void read_map_rect(const MapType p_map_type, const Rect2i &p_area, float *r_dst) const;
+	void read_min_height_rect(const int p_level, const Rect2i &p_blocks, float *r_dst) const;
+	real_t get_min_height(const Rect2i &p_area) const;
+	Vector2 get_height_bounds(const Rect2i &p_area) const;
 	void set_height(const Vector3 &p_global_position, const real_t p_height);
 	real_t get_height(const Vector3 &p_global_position) const;
 	void set_color(const Vector3 &p_global_position, const Color &p_color);
@@ -180,6 +196,10 @@ public:
 
 	void import_images(const TypedArray<Image> &p_images, const Vector3 &p_global_position = V3_ZERO,
 			const real_t p_offset = 0.f, const real_t p_scale = 1.f);
+	Error import_tiles(const String &p_dir, const String &p_pattern, const Vector2i &p_grid_origin = V2I_ZERO,
+			const Vector3 &p_global_position = V3_ZERO, const real_t p_offset = 0.f, const real_t p_scale = 1.f,
+			const Vector2 &p_r16_height_range = Vector2(0.f, 255.f), const Vector2i &p_r16_size = V2I_ZERO,
+			const int p_max_concurrent = 0, const int p_overlap = 0);
 	Error export_image(const String &p_file_name, const MapType p_map_type = TYPE_HEIGHT) const;
 	Ref<Image> layered_to_image(const MapType p_map_type) const;
 
@@ -261,6 +281,59 @@ inline Ref<Terrain3DRegion> Terrain3DData::get_regionp(const Vector3 &p_global_p
 	return _regions.get(get_region_location(p_global_position), Ref<Terrain3DRegion>());
 }
 
+// Calls p_func(Vector2i region_loc) for every region location overlapping the given (descaled) area,
+// whether or not a region exists there.
+template <typename F>
+inline void Terrain3DData::for_each_region_location(const Rect2i &p_area, const F &p_func) const {
+	Vector2i loc_start = V2I_DIVIDE_FLOOR(p_area.position, _region_size);
+	Vector2i loc_end = V2I_DIVIDE_CEIL(p_area.get_end(), _region_size);
+	for (int y = loc_start.y; y < loc_end.y; y++) {
+		for (int x = loc_start.x; x < loc_end.x; x++) {
+			p_func(Vector2i(x, y));
+		}
+	}
+}
+
+// Native region visitor. Calls p_func(Terrain3DRegion *, src Rect2i, dst Rect2i) for every active region
+// within the given (descaled) area, without Variant dispatch.
+// src is in the region's map coordinates, dst is relative to p_area.position.
+template <typename F>
+inline void Terrain3DData::for_each_region(const Rect2i &p_area, const F &p_func) const {
+	for_each_region_location(p_area, [&](const Vector2i &p_region_loc) {
+		Terrain3DRegion *region = get_region_ptr(p_region_loc);
+		if (!region || region->is_deleted()) {
+			return;
+		}
+		Vector2i region_position = p_region_loc * _region_size;
+		Rect2i region_area = p_area.intersection(Rect2i(region_position, _region_sizev));
+		if (!region_area.has_area()) {
+			return;
+		}
+		Rect2i dst_rect(region_area.position - p_area.position, region_area.size);
+		Rect2i src_rect(region_area.position - region_position, region_area.size);
+		p_func(region, src_rect, dst_rect);
+	});
+}
+
+// As above, but regions are gathered on the calling thread then visited in parallel on the WorkerThreadPool.
+// p_func may only write to its own region, or to the dst rect of a shared target.
+template <typename F>
+inline void Terrain3DData::for_each_region_parallel(const Rect2i &p_area, const F &p_func) const {
+	struct Visit {
+		Terrain3DRegion *region;
+		Rect2i src_rect;
+		Rect2i dst_rect;
+	};
+	std::vector<Visit> visits;
+	for_each_region(p_area, [&](Terrain3DRegion *p_region, const Rect2i &p_src_rect, const Rect2i &p_dst_rect) {
+		visits.push_back({ p_region, p_src_rect, p_dst_rect });
+	});
+	parallel_for(int(visits.size()), [&](const int p_index) {
+		const Visit &visit = visits[p_index];
+		p_func(visit.region, visit.src_rect, visit.dst_rect);
+	});
+}
+
 // Inline Map Functions
 
 inline void Terrain3DData::set_height(const Vector3 &p_global_position, const real_t p_height) {
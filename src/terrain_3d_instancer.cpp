@@ -1,7 +1,9 @@
 // Copyright © 2023-2026 Cory Petkovsek, Roope Palmroos, and Contributors.
 
+#include <godot_cpp/classes/geometry2d.hpp>
 #include <godot_cpp/classes/resource_saver.hpp>
 #include <godot_cpp/classes/world3d.hpp>
+#include <cfloat>
 
 #include "constants.h"
 #include "logger.h"
@@ -494,12 +496,20 @@ RID Terrain3DInstancer::_create_multimesh(const int p_mesh_id, const int p_lod,
 	mm = RS->multimesh_create();
 	RS->multimesh_allocate_data(mm, p_xforms.size(), RenderingServer::MULTIMESH_TRANSFORM_3D, true, false, false);
 	RS->multimesh_set_mesh(mm, mesh->get_rid());
-	for (int i = 0; i < p_xforms.size(); i++) {
-		RS->multimesh_instance_set_transform(mm, i, p_xforms[i]);
-		if (i < p_colors.size()) {
-			RS->multimesh_instance_set_color(mm, i, p_colors[i]);
-		}
-	}
+	// Send all instances in one buffer: 12 floats of transform, then 4 of color
+	const int stride = 16;
+	PackedFloat32Array buffer;
+	buffer.resize(p_xforms.size() * stride);
+	float *w = buffer.ptrw();
+	for (int i = 0; i < p_xforms.size(); i++, w += stride) {
+		write_multimesh_transform(w, p_xforms[i]);
+		const Color color = i < p_colors.size() ? p_colors[i] : COLOR_WHITE;
+		w[12] = color.r;
+		w[13] = color.g;
+		w[14] = color.b;
+		w[15] = color.a;
+	}
+	RS->multimesh_set_buffer(mm, buffer);
 	return mm;
 }
 
@@ -1134,6 +1144,204 @@ void Terrain3DInstancer::update_transforms(const AABB &p_aabb) {
 	}
 }
 
+// Appends the faces of a prism spanning the XZ convex hull of the points, from their lowest to highest Y
+void Terrain3DInstancer::_add_obstacle_prism(PackedVector3Array &r_faces, const PackedVector3Array &p_points) const {
+	PackedVector2Array points_2d;
+	points_2d.resize(p_points.size());
+	real_t bottom = FLT_MAX;
+	real_t top = -FLT_MAX;
+	for (int i = 0; i < p_points.size(); i++) {
+		const Vector3 &p = p_points[i];
+		points_2d.set(i, Vector2(p.x, p.z));
+		bottom = MIN(bottom, p.y);
+		top = MAX(top, p.y);
+	}
+	PackedVector2Array hull = Geometry2D::get_singleton()->convex_hull(points_2d);
+	if (hull.size() > 1 && hull[0] == hull[hull.size() - 1]) {
+		hull.resize(hull.size() - 1); // Returned closed
+	}
+	const int count = hull.size();
+	if (count < 3) {
+		return;
+	}
+	// Wind the top cap the same way as terrain faces, so it faces up
+	real_t area = 0.f;
+	for (int i = 0; i < count; i++) {
+		area += hull[i].cross(hull[(i + 1) % count]);
+	}
+	if (area < 0.f) {
+		hull.reverse();
+	}
+	auto top_v = [&](const int p_i) { return Vector3(hull[p_i].x, top, hull[p_i].y); };
+	auto bottom_v = [&](const int p_i) { return Vector3(hull[p_i].x, bottom, hull[p_i].y); };
+	for (int i = 1; i < count - 1; i++) {
+		r_faces.push_back(top_v(0));
+		r_faces.push_back(top_v(i));
+		r_faces.push_back(top_v(i + 1));
+	}
+	for (int i = 0; i < count; i++) {
+		const int j = (i + 1) % count;
+		r_faces.push_back(top_v(i));
+		r_faces.push_back(bottom_v(i));
+		r_faces.push_back(top_v(j));
+		r_faces.push_back(top_v(j));
+		r_faces.push_back(bottom_v(i));
+		r_faces.push_back(bottom_v(j));
+	}
+}
+
+// Generates obstacle faces for instances overlapping the AABB, shaped per mesh asset navigation_obstacle.
+// Only the cells overlapping the AABB are read. Generated meshes, such as grass cards, don't block
+// movement and are skipped.
+PackedVector3Array Terrain3DInstancer::generate_nav_obstacle_faces(const AABB &p_global_aabb) const {
+	PackedVector3Array faces;
+	IS_DATA_INIT(faces);
+	const Terrain3DData *data = _terrain->get_data();
+	const Ref<Terrain3DAssets> assets = _terrain->get_assets();
+	if (assets.is_null()) {
+		return faces;
+	}
+	const bool use_aabb = p_global_aabb.has_volume();
+	const int region_size = _terrain->get_region_size();
+	const real_t vertex_spacing = _terrain->get_vertex_spacing();
+	const real_t cell_width = real_t(CELL_SIZE) * vertex_spacing;
+	const int region_cells = region_size / CELL_SIZE;
+	const Vector3 aabb_end = p_global_aabb.get_end();
+	// Global cell coordinates
+	const Vector2i cell_start = Vector2i(Math::floor(p_global_aabb.position.x / cell_width), Math::floor(p_global_aabb.position.z / cell_width));
+	const Vector2i cell_end = Vector2i(Math::floor(aabb_end.x / cell_width), Math::floor(aabb_end.z / cell_width));
+
+	// Per mesh asset obstacle points and faces in mesh space, built once per call
+	struct Obstacle {
+		Terrain3DMeshAsset::NavObstacle type = Terrain3DMeshAsset::NAV_OBSTACLE_NONE;
+		AABB aabb;
+		PackedVector3Array points;
+	};
+	std::unordered_map<int, Obstacle> obstacles;
+	auto get_obstacle = [&](const int p_mesh_id) -> const Obstacle & {
+		auto it = obstacles.find(p_mesh_id);
+		if (it != obstacles.end()) {
+			return it->second;
+		}
+		Obstacle &obstacle = obstacles[p_mesh_id];
+		const Ref<Terrain3DMeshAsset> ma = assets->get_mesh_asset(p_mesh_id);
+		if (ma.is_null() || !ma->is_enabled() || ma->get_generated_type() != Terrain3DMeshAsset::TYPE_NONE) {
+			return obstacle;
+		}
+		const Ref<Mesh> mesh = ma->get_mesh(0);
+		if (mesh.is_null()) {
+			return obstacle;
+		}
+		obstacle.type = ma->get_navigation_obstacle();
+		obstacle.aabb = mesh->get_aabb();
+		switch (obstacle.type) {
+			case Terrain3DMeshAsset::NAV_OBSTACLE_AABB: {
+				for (int i = 0; i < 8; i++) {
+					obstacle.points.push_back(obstacle.aabb.get_endpoint(i));
+				}
+			} break;
+			case Terrain3DMeshAsset::NAV_OBSTACLE_HULL: {
+				obstacle.points = ma->get_nav_obstacle_hull();
+			} break;
+			case Terrain3DMeshAsset::NAV_OBSTACLE_MESH: {
+				obstacle.points = mesh->get_faces();
+			} break;
+			default:
+				break;
+		}
+		if (obstacle.points.is_empty()) {
+			obstacle.type = Terrain3DMeshAsset::NAV_OBSTACLE_NONE;
+		}
+		LOG(DEBUG, "Mesh ID ", p_mesh_id, " navigation obstacle type: ", obstacle.type, ", points: ", obstacle.points.size());
+		return obstacle;
+	};
+
+	// Regions within the AABB, or all of them
+	TypedArray<Vector2i> region_locations;
+	if (use_aabb) {
+		const Vector2i loc_start = V2I_DIVIDE_FLOOR(cell_start, region_cells);
+		const Vector2i loc_end = V2I_DIVIDE_FLOOR(cell_end, region_cells);
+		for (int y = loc_start.y; y <= loc_end.y; y++) {
+			for (int x = loc_start.x; x <= loc_end.x; x++) {
+				if (data->has_region(Vector2i(x, y))) {
+					region_locations.push_back(Vector2i(x, y));
+				}
+			}
+		}
+	} else {
+		region_locations = data->get_region_locations();
+	}
+
+	int instance_count = 0;
+	PackedVector3Array points;
+	for (const Vector2i &region_loc : region_locations) {
+		const Terrain3DRegion *region = data->get_region_ptr(region_loc);
+		if (!region || region->is_deleted()) {
+			continue;
+		}
+		// Cells of this region within the AABB
+		const Vector2i region_cell = region_loc * region_cells;
+		Vector2i local_start = V2I_ZERO;
+		Vector2i local_end = V2I(region_cells - 1);
+		if (use_aabb) {
+			local_start = (cell_start - region_cell).clamp(V2I_ZERO, V2I(region_cells - 1));
+			local_end = (cell_end - region_cell).clamp(V2I_ZERO, V2I(region_cells - 1));
+		}
+		const Dictionary mesh_inst_dict = region->get_instances();
+		if (mesh_inst_dict.is_empty()) {
+			continue;
+		}
+		const Vector3 global_local_offset = Vector3(region_loc.x * region_size * vertex_spacing, 0.f, region_loc.y * region_size * vertex_spacing);
+		for (const int &mesh_id : mesh_inst_dict.keys()) {
+			const Obstacle &obstacle = get_obstacle(mesh_id);
+			if (obstacle.type == Terrain3DMeshAsset::NAV_OBSTACLE_NONE) {
+				continue;
+			}
+			const Dictionary cell_inst_dict = mesh_inst_dict[mesh_id];
+			for (int cy = local_start.y; cy <= local_end.y; cy++) {
+				for (int cx = local_start.x; cx <= local_end.x; cx++) {
+					const Vector2i cell = Vector2i(cx, cy);
+					if (!cell_inst_dict.has(cell)) {
+						continue;
+					}
+					const Array triple = cell_inst_dict[cell];
+					const TypedArray<Transform3D> xforms = triple[0];
+					for (int i = 0; i < xforms.size(); i++) {
+						Transform3D t = xforms[i];
+						t.origin += global_local_offset;
+						if (use_aabb && !p_global_aabb.intersects(t.xform(obstacle.aabb))) {
+							continue;
+						}
+						instance_count++;
+						points.resize(obstacle.points.size());
+						const Vector3 *src = obstacle.points.ptr();
+						Vector3 *dst = points.ptrw();
+						for (int64_t j = 0; j < points.size(); j++) {
+							dst[j] = t.xform(src[j]);
+						}
+						if (obstacle.type == Terrain3DMeshAsset::NAV_OBSTACLE_MESH) {
+							faces.append_array(points);
+						} else {
+							_add_obstacle_prism(faces, points);
+						}
+					}
+				}
+			}
+		}
+	}
+	LOG(DEBUG, "Generated ", faces.size() / 3, " navigation obstacle faces for ", instance_count, " instances");
+	return faces;
+}
+
+// Adds obstacle faces for instances overlapping the AABB to navigation source geometry
+void Terrain3DInstancer::add_nav_source_geometry(const Ref<NavigationMeshSourceGeometryData3D> &p_source, const AABB &p_global_aabb) const {
+	ERR_FAIL_COND(p_source.is_null());
+	const PackedVector3Array faces = generate_nav_obstacle_faces(p_global_aabb);
+	if (!faces.is_empty()) {
+		p_source->add_faces(faces, Transform3D());
+	}
+}
+
 int Terrain3DInstancer::get_closest_mesh_id(const Vector3 &p_global_position) const {
 	LOG(INFO, "Finding mesh asset ID closest to specified position ", p_global_position);
 	Vector2i region_loc = _terrain->get_data()->get_region_location(p_global_position);
@@ -1204,28 +1412,56 @@ void Terrain3DInstancer::copy_paste_dfr(const Terrain3DRegion *p_src_region, con
 	Vector3 dst_translate = Vector3(dst_offset.x, 0.f, dst_offset.y) * vertex_spacing;
 
 	// Get all Cell locations in rect, which is already in region space.
-	Vector2i cell_start = p_src_rect.get_position() / CELL_SIZE;
-	Vector2i steps = p_src_rect.get_size() / CELL_SIZE;
-	Dictionary cells_to_copy;
-	for (int x = cell_start.x; x < cell_start.x + steps.x; x++) {
-		for (int y = cell_start.y; y < cell_start.y + steps.y; y++) {
-			cells_to_copy[Vector2i(x, y)] = 0;
-		}
-	}
+	Rect2i cell_rect(p_src_rect.get_position() / CELL_SIZE, p_src_rect.get_size() / CELL_SIZE);
+
+	// If the offset is cell aligned, as when changing region sizes, each source cell maps to exactly one
+	// destination cell, so whole cells are translated and written once instead of rebinning each transform.
+	bool cell_aligned = dst_offset.x % CELL_SIZE == 0 && dst_offset.y % CELL_SIZE == 0;
+	Vector2i cell_offset = dst_offset / CELL_SIZE;
 
 	// For each mesh, for each cell, if in rect, convert xforms to target region space, append to target region.
 	Dictionary mesh_inst_dict = p_src_region->get_instances();
+	Dictionary dst_mesh_inst_dict = p_dst_region->get_instances();
 	Array mesh_types = mesh_inst_dict.keys();
 	for (const int &mesh_id : mesh_types) {
 		TypedArray<Transform3D> xforms;
 		PackedColorArray colors;
-		Dictionary cell_inst_dict = p_src_region->get_instances()[mesh_id];
+		Dictionary cell_inst_dict = mesh_inst_dict[mesh_id];
+		Dictionary dst_cell_inst_dict = dst_mesh_inst_dict.get(mesh_id, Dictionary());
 		Array cell_locs = cell_inst_dict.keys();
 		for (const Vector2i &cell : cell_locs) {
-			if (cells_to_copy.has(cell)) {
-				Array triple = cell_inst_dict[cell];
-				TypedArray<Transform3D> cell_xforms = triple[0];
-				PackedColorArray cell_colors = triple[1];
+			if (!cell_rect.has_point(cell)) {
+				continue;
+			}
+			Array triple = cell_inst_dict[cell];
+			TypedArray<Transform3D> cell_xforms = triple[0];
+			PackedColorArray cell_colors = triple[1];
+			if (cell_aligned) {
+				Vector2i dst_cell = cell + cell_offset;
+				Array dst_triple = dst_cell_inst_dict.get(dst_cell, Array());
+				TypedArray<Transform3D> dst_xforms;
+				PackedColorArray dst_colors;
+				if (dst_triple.size() == 3) {
+					dst_xforms = dst_triple[0];
+					dst_colors = dst_triple[1];
+				} else {
+					dst_triple.resize(3);
+				}
+				int64_t start = dst_xforms.size();
+				dst_xforms.resize(start + cell_xforms.size());
+				for (int i = 0; i < cell_xforms.size(); i++) {
+					Transform3D t = cell_xforms[i];
+					t.origin += dst_translate;
+					dst_xforms[start + i] = t;
+				}
+				dst_colors.append_array(cell_colors);
+				// Must write back since there are copy constructors somewhere
+				// see godot-cpp#1149
+				dst_triple[0] = dst_xforms;
+				dst_triple[1] = dst_colors;
+				dst_triple[2] = true;
+				dst_cell_inst_dict[dst_cell] = dst_triple;
+			} else {
 				for (int i = 0; i < cell_xforms.size(); i++) {
 					Transform3D t = cell_xforms[i];
 					t.origin += dst_translate;
@@ -1234,11 +1470,20 @@ void Terrain3DInstancer::copy_paste_dfr(const Terrain3DRegion *p_src_region, con
 				}
 			}
 		}
+		if (cell_aligned) {
+			if (!dst_cell_inst_dict.is_empty()) {
+				dst_mesh_inst_dict[mesh_id] = dst_cell_inst_dict;
+			}
+			continue;
+		}
 		if (xforms.size() == 0) {
 			continue;
 		}
 		append_region(Ref<Terrain3DRegion>(p_dst_region), mesh_id, xforms, colors, false);
 	}
+	if (cell_aligned) {
+		Ref<Terrain3DRegion>(p_dst_region)->set_modified(true);
+	}
 }
 
 // Changes the ID of a mesh, without changing the mesh on the ground
@@ -1359,6 +1604,8 @@ void Terrain3DInstancer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("append_location", "region_location", "mesh_id", "transforms", "colors", "update"), &Terrain3DInstancer::append_location, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("append_region", "region", "mesh_id", "transforms", "colors", "update"), &Terrain3DInstancer::append_region, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("update_transforms", "aabb"), &Terrain3DInstancer::update_transforms);
+	ClassDB::bind_method(D_METHOD("generate_nav_obstacle_faces", "global_aabb"), &Terrain3DInstancer::generate_nav_obstacle_faces);
+	ClassDB::bind_method(D_METHOD("add_nav_source_geometry", "source", "global_aabb"), &Terrain3DInstancer::add_nav_source_geometry);
 	ClassDB::bind_method(D_METHOD("get_closest_mesh_id", "global_position"), &Terrain3DInstancer::get_closest_mesh_id);
 	ClassDB::bind_method(D_METHOD("update_mmis", "mesh_id", "region_location", "rebuild_all"), &Terrain3DInstancer::update_mmis, DEFVAL(-1), DEFVAL(V2I_MAX), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("swap_ids", "src_id", "dest_id"), &Terrain3DInstancer::swap_ids);
@@ -626,6 +626,10 @@ void Terrain3DMaterial::_update_shader() {
 		_set("noise_texture", noise_tex);
 	}
 
+	// Rerender the displacement buffer with the new shader
+	if (_terrain->get_tessellation_level() > 0) {
+		_terrain->clear_displacement_buffer();
+	}
 	notify_property_list_changed();
 }
 
@@ -688,6 +692,11 @@ void Terrain3DMaterial::_update_uniforms(const RID &p_material, const uint32_t p
 	real_t subdiv = pow(2.f, tessellation_level);
 	RS->material_set_param(p_material, "_subdiv", subdiv);
 	RS->material_set_param(p_material, "_tessellation_level", tessellation_level);
+	real_t cdlod_range = 0.f;
+	if (_terrain->get_mesh_mode() == Terrain3D::MESH_MODE_CDLOD) {
+		cdlod_range = _terrain->get_cdlod_lod_distance() * mesh_size * spacing / subdiv;
+	}
+	RS->material_set_param(p_material, "_cdlod_range", cdlod_range);
 	RS->material_set_param(p_material, "_displacement_scale", _displacement_scale);
 	RS->material_set_param(p_material, "_displacement_sharpness", _displacement_sharpness);
 
@@ -1278,6 +1287,10 @@ bool Terrain3DMaterial::_set(const StringName &p_name, const Variant &p_property
 		RS->material_set_param(_material, p_name, p_property);
 		RS->material_set_param(_buffer_material, p_name, p_property);
 	}
+	// Rerender the displacement buffer with the new value
+	if (_terrain->get_tessellation_level() > 0) {
+		_terrain->clear_displacement_buffer();
+	}
 	return true;
 }
 
@@ -4,6 +4,7 @@
 #include <godot_cpp/classes/editor_paths.hpp>
 #include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/image_texture.hpp>
+#include <godot_cpp/classes/convex_polygon_shape3d.hpp>
 #include <godot_cpp/classes/material.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/quad_mesh.hpp>
@@ -166,6 +167,7 @@ void Terrain3DMeshAsset::clear() {
 	_visibility_layers = 1;
 	_material_override.unref();
 	_material_overlay.unref();
+	_navigation_obstacle = NAV_OBSTACLE_HULL;
 	_last_lod = MAX_LOD_COUNT - 1;
 	_last_shadow_lod = MAX_LOD_COUNT - 1;
 	_shadow_impostor = 0;
@@ -430,6 +432,34 @@ void Terrain3DMeshAsset::set_material_overlay(const Ref<Material> &p_material) {
 	emit_signal("instancer_setting_changed", _id);
 }
 
+void Terrain3DMeshAsset::set_navigation_obstacle(const NavObstacle p_obstacle) {
+	SET_IF_DIFF(_navigation_obstacle, p_obstacle);
+	LOG(INFO, "ID ", _id, ", ", _name, ": Setting navigation obstacle: ", p_obstacle);
+	std::lock_guard<std::mutex> lock(_nav_hull_mutex);
+	_nav_hull_mesh.unref();
+	_nav_hull_points.clear();
+}
+
+// Returns the convex hull points of the first LOD mesh, in mesh space. Built on first use and cached
+// until the mesh changes, since building a convex shape is expensive.
+PackedVector3Array Terrain3DMeshAsset::get_nav_obstacle_hull() const {
+	const Ref<Mesh> mesh = get_mesh(0);
+	std::lock_guard<std::mutex> lock(_nav_hull_mutex);
+	if (mesh.is_null()) {
+		_nav_hull_mesh.unref();
+		_nav_hull_points.clear();
+	} else if (mesh != _nav_hull_mesh) {
+		LOG(DEBUG, "ID ", _id, ", ", _name, ": Building navigation obstacle hull");
+		_nav_hull_mesh = mesh;
+		_nav_hull_points.clear();
+		const Ref<ConvexPolygonShape3D> shape = mesh->create_convex_shape(true, false);
+		if (shape.is_valid()) {
+			_nav_hull_points = shape->get_points();
+		}
+	}
+	return _nav_hull_points;
+}
+
 void Terrain3DMeshAsset::set_generated_faces(const int p_count) {
 	SET_IF_DIFF(_generated_faces, CLAMP(p_count, 1, 3));
 	LOG(INFO, "ID ", _id, ", ", _name, ": Setting generated face count: ", _generated_faces);
@@ -586,6 +616,10 @@ void Terrain3DMeshAsset::_bind_methods() {
 	BIND_ENUM_CONSTANT(TYPE_NONE);
 	BIND_ENUM_CONSTANT(TYPE_TEXTURE_CARD);
 	BIND_ENUM_CONSTANT(TYPE_MAX);
+	BIND_ENUM_CONSTANT(NAV_OBSTACLE_NONE);
+	BIND_ENUM_CONSTANT(NAV_OBSTACLE_AABB);
+	BIND_ENUM_CONSTANT(NAV_OBSTACLE_HULL);
+	BIND_ENUM_CONSTANT(NAV_OBSTACLE_MESH);
 
 	ADD_SIGNAL(MethodInfo("id_changed"));
 	ADD_SIGNAL(MethodInfo("setting_changed"));
@@ -622,6 +656,8 @@ void Terrain3DMeshAsset::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_material_override"), &Terrain3DMeshAsset::get_material_override);
 	ClassDB::bind_method(D_METHOD("set_material_overlay", "material"), &Terrain3DMeshAsset::set_material_overlay);
 	ClassDB::bind_method(D_METHOD("get_material_overlay"), &Terrain3DMeshAsset::get_material_overlay);
+	ClassDB::bind_method(D_METHOD("set_navigation_obstacle", "obstacle"), &Terrain3DMeshAsset::set_navigation_obstacle);
+	ClassDB::bind_method(D_METHOD("get_navigation_obstacle"), &Terrain3DMeshAsset::get_navigation_obstacle);
 
 	ClassDB::bind_method(D_METHOD("set_generated_faces", "count"), &Terrain3DMeshAsset::set_generated_faces);
 	ClassDB::bind_method(D_METHOD("get_generated_faces"), &Terrain3DMeshAsset::get_generated_faces);
@@ -674,6 +710,7 @@ void Terrain3DMeshAsset::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_layers", PROPERTY_HINT_LAYERS_3D_RENDER), "set_visibility_layers", "get_visibility_layers");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "material_override", PROPERTY_HINT_RESOURCE_TYPE, "BaseMaterial3D,ShaderMaterial"), "set_material_override", "get_material_override");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "material_overlay", PROPERTY_HINT_RESOURCE_TYPE, "BaseMaterial3D,ShaderMaterial"), "set_material_overlay", "get_material_overlay");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "navigation_obstacle", PROPERTY_HINT_ENUM, "None,AABB,Convex Hull,Mesh"), "set_navigation_obstacle", "get_navigation_obstacle");
 
 	ADD_GROUP("Generated Mesh", "");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "generated_faces", PROPERTY_HINT_NONE), "set_generated_faces", "get_generated_faces");
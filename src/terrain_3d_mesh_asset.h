@@ -9,6 +9,7 @@
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/classes/texture2d.hpp>
+#include <mutex>
 
 #include "constants.h"
 #include "terrain_3d_asset_resource.h"
@@ -47,6 +48,13 @@ public:
 		TYPE_MAX,
 	};
 
+	enum NavObstacle {
+		NAV_OBSTACLE_NONE,
+		NAV_OBSTACLE_AABB,
+		NAV_OBSTACLE_HULL,
+		NAV_OBSTACLE_MESH,
+	};
+
 	static constexpr int MAX_LOD_COUNT = 10;
 	static constexpr int SHADOW_LOD_ID = -1; // ID used for the shadow lod in instancer
 
@@ -63,6 +71,7 @@ private:
 	uint32_t _visibility_layers = 1;
 	Ref<Material> _material_override;
 	Ref<Material> _material_overlay;
+	NavObstacle _navigation_obstacle = NAV_OBSTACLE_HULL;
 	int _last_lod = MAX_LOD_COUNT - 1;
 	int _last_shadow_lod = MAX_LOD_COUNT - 1;
 	int _shadow_impostor = 0;
@@ -74,6 +83,10 @@ private:
 	TypedArray<Mesh> _meshes;
 	TypedArray<Mesh> _pending_meshes; // Queue to avoid warnings from RS on mesh swap
 	uint32_t _instance_count = 0;
+	// Convex hull points of the mesh used for NAV_OBSTACLE_HULL, valid while the mesh is unchanged
+	mutable std::mutex _nav_hull_mutex;
+	mutable Ref<Mesh> _nav_hull_mesh;
+	mutable PackedVector3Array _nav_hull_points;
 
 	void _clear_lod_ranges();
 	static bool _sort_lod_nodes(const Node *a, const Node *b);
@@ -126,6 +139,9 @@ public:
 	Ref<Material> get_material_override() const { return _material_override; }
 	void set_material_overlay(const Ref<Material> &p_material);
 	Ref<Material> get_material_overlay() const { return _material_overlay; }
+	void set_navigation_obstacle(const NavObstacle p_obstacle);
+	NavObstacle get_navigation_obstacle() const { return _navigation_obstacle; }
+	PackedVector3Array get_nav_obstacle_hull() const;
 
 	void set_generated_faces(const int p_count);
 	int get_generated_faces() const { return _generated_faces; }
@@ -175,6 +191,7 @@ protected:
 };
 
 VARIANT_ENUM_CAST(Terrain3DMeshAsset::GenType);
+VARIANT_ENUM_CAST(Terrain3DMeshAsset::NavObstacle);
 
 inline TypedArray<Mesh> Terrain3DMeshAsset::_get_meshes() const {
 	if (!_pending_meshes.is_empty()) {
@@ -13,32 +13,79 @@
 ///////////////////////////
 
 void Terrain3DMesher::_generate_mesh_types() {
-	_clear_mesh_types();
+	// Release the previous meshes after acquiring, so meshes that didn't change are kept
+	const Array old_mesh_rids = _mesh_rids;
+	_mesh_rids = Array();
 	LOG(INFO, "Generating all Mesh segments for clipmap of size ", _mesh_size);
-	// Create initial set of Mesh blocks to build the clipmap
+	_mesh_sizes = {
+		V2I(_mesh_size), // TILE
+		Vector2i(2, _mesh_size * 4 + 8), // EDGE_A
+		Vector2i(_mesh_size * 4 + 4, 2), // EDGE_B
+		Vector2i(4, _mesh_size), // FILL_A
+		Vector2i(_mesh_size, 4), // FILL_B
+		Vector2i(2, _mesh_size * 4 + 2), // STANDARD_TRIM_A
+		Vector2i(_mesh_size * 4 + 2, 2), // STANDARD_TRIM_B
+		V2I(_mesh_size), // STANDARD_TILE
+		Vector2i(2, _mesh_size * 4 + 8), // STANDARD_EDGE_A
+		Vector2i(_mesh_size * 4 + 4, 2), // STANDARD_EDGE_B
+	};
+	// Get the set of Mesh blocks to build the clipmap, shared with other meshers
 	// # 0 TILE - mesh_size x mesh_size tiles
-	_mesh_rids.push_back(_generate_mesh(V2I(_mesh_size)));
+	_mesh_rids.push_back(_acquire_mesh(V2I(_mesh_size)));
 	// # 1 EDGE_A - 2 by (mesh_size * 4 + 8) strips to bridge LOD transitions along +-Z axis
-	_mesh_rids.push_back(_generate_mesh(Vector2i(2, _mesh_size * 4 + 8)));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(2, _mesh_size * 4 + 8)));
 	// # 2 EDGE_B - (mesh_size * 4 + 4) by 2 strips to bridge LOD transitions along +-X axis
-	_mesh_rids.push_back(_generate_mesh(Vector2i(_mesh_size * 4 + 4, 2)));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(_mesh_size * 4 + 4, 2)));
 	// # 3 FILL_A - 4 by mesh_size
-	_mesh_rids.push_back(_generate_mesh(Vector2i(4, _mesh_size)));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(4, _mesh_size)));
 	// # 4 FILL_B - mesh_size by 4
-	_mesh_rids.push_back(_generate_mesh(Vector2i(_mesh_size, 4)));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(_mesh_size, 4)));
 	// # 5 STANDARD_TRIM_A - 2 by (mesh_size * 4 + 2) strips for LOD0 +-Z axis edge
-	_mesh_rids.push_back(_generate_mesh(Vector2i(2, _mesh_size * 4 + 2), true));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(2, _mesh_size * 4 + 2), true));
 	// # 6 STANDARD_TRIM_B - (mesh_size * 4 + 2) by 2 strips for LOD0 +-X axis edge
-	_mesh_rids.push_back(_generate_mesh(Vector2i(_mesh_size * 4 + 2, 2), true));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(_mesh_size * 4 + 2, 2), true));
 	// # 7 STANDARD_TILE - mesh_size x mesh_size tiles
-	_mesh_rids.push_back(_generate_mesh(Vector2i(_mesh_size, _mesh_size), true));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(_mesh_size, _mesh_size), true));
 	// # 8 STANDARD_EDGE_A - 2 by (mesh_size * 4 + 8) strips to bridge LOD transitions along +-Z axis
-	_mesh_rids.push_back(_generate_mesh(Vector2i(2, _mesh_size * 4 + 8), true));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(2, _mesh_size * 4 + 8), true));
 	// # 9 STANDARD_EDGE_B - (mesh_size * 4 + 4) by 2 strips to bridge LOD transitions along +-X axis
-	_mesh_rids.push_back(_generate_mesh(Vector2i(_mesh_size * 4 + 4, 2), true));
+	_mesh_rids.push_back(_acquire_mesh(Vector2i(_mesh_size * 4 + 4, 2), true));
+	for (const RID &rid : old_mesh_rids) {
+		_release_mesh(rid);
+	}
 	return;
 }
 
+uint64_t Terrain3DMesher::_get_mesh_key(const Vector2i &p_size, const bool p_standard_grid) {
+	return (uint64_t(uint32_t(p_size.x)) << 32) | (uint64_t(uint32_t(p_size.y)) << 1) | uint64_t(p_standard_grid);
+}
+
+// Returns the cached mesh of this size and grid type, generating it if needed.
+RID Terrain3DMesher::_acquire_mesh(const Vector2i &p_size, const bool p_standard_grid) {
+	CachedMesh &cached = _mesh_cache[_get_mesh_key(p_size, p_standard_grid)];
+	if (cached.mesh.is_null()) {
+		cached.mesh = _generate_mesh(p_size, p_standard_grid);
+	} else {
+		LOG(DEBUG, "Reusing cached ", p_standard_grid ? "standard " : "", "grid mesh of size: ", p_size);
+	}
+	cached.refs++;
+	return cached.mesh;
+}
+
+// Frees the cached mesh once no mesher uses it.
+void Terrain3DMesher::_release_mesh(const RID &p_mesh) {
+	for (auto it = _mesh_cache.begin(); it != _mesh_cache.end(); ++it) {
+		if (it->second.mesh == p_mesh) {
+			if (--it->second.refs <= 0) {
+				LOG(DEBUG, "Freeing cached mesh: ", p_mesh);
+				RS->free_rid(p_mesh);
+				_mesh_cache.erase(it);
+			}
+			return;
+		}
+	}
+}
+
 RID Terrain3DMesher::_generate_mesh(const Vector2i &p_size, const bool p_standard_grid) {
 	PackedVector3Array vertices;
 	PackedInt32Array indices;
@@ -106,7 +153,6 @@ RID Terrain3DMesher::_instantiate_mesh(const PackedVector3Array &p_vertices, con
 
 	LOG(DEBUG, "Setting custom aabb: ", p_aabb.position, ", ", p_aabb.size);
 	RS->mesh_set_custom_aabb(mesh, p_aabb);
-	RS->mesh_surface_set_material(mesh, 0, _material.is_valid() ? _material : RID());
 
 	return mesh;
 }
@@ -115,8 +161,31 @@ void Terrain3DMesher::_generate_clipmap() {
 	_clear_clipmap();
 	_generate_mesh_types();
 	_generate_offset_data();
+	_lod_snaps.clear();
+	if (_cdlod) {
+		LOG(DEBUG, "CDLOD tiles are created as they are selected");
+		return;
+	}
 	LOG(DEBUG, "Creating instances for all mesh segments for clipmap of size ", _mesh_size, " for ", _lods, " LODs");
+	if (_multimesh) {
+		_multimeshes.resize(_mesh_rids.size());
+	}
 	for (int level = 0; level < _lods + _tessellation_level; level++) {
+		// Tiles, edges a/b, fills a/b on LOD1+ or trims a/b on LOD0
+		const std::vector<int> counts = { (level == 0) ? 16 : 12, 2, 2, 2, 2 };
+		_instance_counts.push_back(counts);
+		if (_multimesh) {
+			// Reserve a range of each MultiMesh for this LOD's instances
+			std::vector<int> offsets;
+			for (int mesh = 0; mesh < int(counts.size()); mesh++) {
+				MultiMeshType &mm = _multimeshes[_get_mesh_type(level, mesh)];
+				offsets.push_back(mm.count);
+				mm.count += counts[mesh];
+			}
+			_multimesh_offsets.push_back(offsets);
+			continue;
+		}
+
 		Array lod;
 		// 12 Tiles LOD1+, 16 for LOD0
 		Array tile_rids;
@@ -179,6 +248,19 @@ void Terrain3DMesher::_generate_clipmap() {
 		// Append LOD to _lod_rids array
 		_clipmap_rids.append(lod);
 	}
+
+	for (int type = 0; type < int(_multimeshes.size()); type++) {
+		MultiMeshType &mm = _multimeshes[type];
+		if (mm.count == 0) {
+			continue;
+		}
+		mm.multimesh = RS->multimesh_create();
+		RS->multimesh_allocate_data(mm.multimesh, mm.count, RenderingServer::MULTIMESH_TRANSFORM_3D);
+		RS->multimesh_set_mesh(mm.multimesh, _mesh_rids[type]);
+		mm.buffer.resize(mm.count * MULTIMESH_STRIDE);
+		mm.buffer.fill(0.f);
+		mm.instance = RS->instance_create2(mm.multimesh, _scenario);
+	}
 }
 
 // Precomputes all instance offset data into lookup arrays that match created instances.
@@ -249,6 +331,135 @@ void Terrain3DMesher::_generate_offset_data() {
 	return;
 }
 
+// Returns the height range below the world XZ footprint, grown by a vertex at the LOD spacing for
+// vertex morphing. Areas without regions are rendered flat at 0 by the world background.
+Vector2 Terrain3DMesher::_get_height_bounds(const Rect2 &p_footprint, const real_t p_lod_spacing) const {
+	const Terrain3DData *data = _terrain->get_data();
+	const real_t terrain_spacing = _terrain->get_vertex_spacing();
+	const Rect2 grown = p_footprint.grow(p_lod_spacing);
+	const Vector2i start = Vector2i((grown.position / terrain_spacing).floor());
+	const Vector2i end = Vector2i((grown.get_end() / terrain_spacing).ceil()) + V2I(1);
+	const Rect2i area = Rect2i(start, end - start);
+	Vector2 bounds = data->get_height_bounds(area);
+
+	const int region_size = data->get_region_size();
+	const Vector2i area_end = area.get_end() - V2I(1);
+	const Vector2i loc_start = V2I_DIVIDE_FLOOR(start, region_size);
+	const Vector2i loc_end = V2I_DIVIDE_FLOOR(area_end, region_size);
+	bool covered = true;
+	for (int y = loc_start.y; y <= loc_end.y && covered; y++) {
+		for (int x = loc_start.x; x <= loc_end.x; x++) {
+			if (!data->has_region(Vector2i(x, y))) {
+				covered = false;
+				break;
+			}
+		}
+	}
+	if (!covered) {
+		bounds = Vector2(std::fmin(bounds.x, 0.f), std::fmax(bounds.y, 0.f));
+	}
+	return bounds;
+}
+
+// Returns the min and max Y to cull the footprint with: the heights below it, plus margins.
+Vector2 Terrain3DMesher::_get_cull_range(const Rect2 &p_footprint, const real_t p_lod_spacing) const {
+	Vector2 bounds = _get_height_bounds(p_footprint, p_lod_spacing);
+	if (std::isnan(bounds.x)) {
+		bounds = V2_ZERO;
+	}
+	// Displacement offsets vertices by up to displacement_scale in any direction
+	const real_t margin = _cull_margin + (_tessellation_level > 0 ? _terrain->get_displacement_scale() : 0.f);
+	return Vector2(bounds.x - margin, bounds.y + margin);
+}
+
+// Sets the instance's custom AABB to its mesh extents and the heights below it, plus margins.
+// Instances are scaled only on XZ, so the local Y range is the world height range.
+void Terrain3DMesher::_update_instance_aabb(const RID &p_instance, const Rect2 &p_footprint, const real_t p_lod_spacing) const {
+	if (!_terrain->get_data()) {
+		return;
+	}
+	const Vector2 range = _get_cull_range(p_footprint, p_lod_spacing);
+	const Vector2 local_size = p_footprint.size / p_lod_spacing;
+	const AABB aabb = AABB(Vector3(0.f, range.x, 0.f), Vector3(local_size.x, range.y - range.x, local_size.y));
+	RS->instance_set_custom_aabb(p_instance, aabb);
+}
+
+// Returns true if instances over areas without regions should be hidden. The shader discards those
+// vertices when there is no world background, so they would only cost vertex processing.
+bool Terrain3DMesher::_is_culling_empty() const {
+	if (!_use_height_bounds || !_terrain->get_data()) {
+		return false;
+	}
+	const Ref<Terrain3DMaterial> material = _terrain->get_material();
+	return material.is_valid() && material->get_world_background() == Terrain3DMaterial::NONE;
+}
+
+// Returns true if any region lies below the world XZ footprint, grown by a vertex at the LOD spacing
+// for vertex morphing.
+bool Terrain3DMesher::_has_region(const Rect2 &p_footprint, const real_t p_lod_spacing) const {
+	const Terrain3DData *data = _terrain->get_data();
+	const real_t region_size = real_t(data->get_region_size()) * _terrain->get_vertex_spacing();
+	const Rect2 grown = p_footprint.grow(p_lod_spacing);
+	const Vector2i loc_start = Vector2i((grown.position / region_size).floor());
+	const Vector2i loc_end = Vector2i((grown.get_end() / region_size).floor());
+	for (int y = loc_start.y; y <= loc_end.y; y++) {
+		for (int x = loc_start.x; x <= loc_end.x; x++) {
+			if (data->has_region(Vector2i(x, y))) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// Hides or shows the instance if its empty state changed. Returns the RenderingServer calls made.
+int Terrain3DMesher::_set_instance_empty(const RID &p_instance, const bool p_empty, const bool p_visible) {
+	const uint64_t id = p_instance.get_id();
+	if (p_empty == (_empty_instances.count(id) > 0)) {
+		return 0;
+	}
+	if (p_empty) {
+		_empty_instances.insert(id);
+	} else {
+		_empty_instances.erase(id);
+	}
+	RS->instance_set_visible(p_instance, p_visible && !p_empty);
+	return 1;
+}
+
+// Sets the MultiMesh AABB to the union of its instance footprints. The MultiMesh instance has an
+// identity transform, so its local space is world space.
+void Terrain3DMesher::_update_multimesh_aabb(const int p_type) const {
+	const MultiMeshType &mm = _multimeshes[p_type];
+	if (mm.multimesh.is_null()) {
+		return;
+	}
+	Rect2 area;
+	bool has_area = false;
+	real_t lod_spacing = 0.f;
+	for (int lod = 0; lod < int(_footprints.size()) && lod < int(_instance_counts.size()); lod++) {
+		const std::vector<Rect2> &footprints = _footprints[lod];
+		const std::vector<int> &counts = _instance_counts[lod];
+		size_t index = 0;
+		for (int mesh = 0; mesh < int(counts.size()); mesh++) {
+			if (_get_mesh_type(lod, mesh) == p_type) {
+				for (int i = 0; i < counts[mesh] && index + i < footprints.size(); i++) {
+					area = has_area ? area.merge(footprints[index + i]) : footprints[index + i];
+					has_area = true;
+				}
+				lod_spacing = MAX(lod_spacing, pow(2.f, lod) * _vertex_spacing / pow(2.f, _tessellation_level));
+			}
+			index += counts[mesh];
+		}
+	}
+	if (!has_area) {
+		return;
+	}
+	const Vector2 range = (_use_height_bounds && _terrain->get_data()) ? _get_cull_range(area, lod_spacing) : _height_range;
+	const AABB aabb = AABB(Vector3(area.position.x, range.x, area.position.y), Vector3(area.size.x, range.y - range.x, area.size.y));
+	RS->multimesh_set_custom_aabb(mm.multimesh, aabb);
+}
+
 // Frees all clipmap instance RIDs. Mesh rids must be freed separately.
 void Terrain3DMesher::_clear_clipmap() {
 	LOG(INFO, "Freeing all clipmap instances");
@@ -260,25 +471,222 @@ void Terrain3DMesher::_clear_clipmap() {
 		}
 	}
 	_clipmap_rids.clear();
+	_empty_instances.clear();
+	for (const MultiMeshType &mm : _multimeshes) {
+		if (mm.instance.is_valid()) {
+			RS->free_rid(mm.instance);
+		}
+		if (mm.multimesh.is_valid()) {
+			RS->free_rid(mm.multimesh);
+		}
+	}
+	_multimeshes.clear();
+	_multimesh_offsets.clear();
+	for (const std::pair<const uint64_t, CdlodPatch> &entry : _cdlod_patches) {
+		RS->free_rid(entry.second.instance);
+	}
+	for (const RID &rid : _cdlod_pool) {
+		RS->free_rid(rid);
+	}
+	_cdlod_patches.clear();
+	_cdlod_pool.clear();
+	_cdlod_bounds.clear();
+	_cdlod_dirty = true;
+	_instance_counts.clear();
+	_footprints.clear();
 	return;
 }
 
-// Frees all Mesh RIDs use for clipmap instances.
+// Releases all Mesh RIDs used for clipmap instances. They are freed once unused by all meshers.
 void Terrain3DMesher::_clear_mesh_types() {
-	LOG(INFO, "Freeing all clipmap meshes");
+	LOG(INFO, "Releasing all clipmap meshes");
 	for (const RID &rid : _mesh_rids) {
-		RS->free_rid(rid);
+		_release_mesh(rid);
 	}
 	_mesh_rids.clear();
 	return;
 }
 
+// Returns all instances drawing this clipmap, in either mode.
+std::vector<RID> Terrain3DMesher::_get_instances() const {
+	std::vector<RID> instances;
+	for (const MultiMeshType &mm : _multimeshes) {
+		if (mm.instance.is_valid()) {
+			instances.push_back(mm.instance);
+		}
+	}
+	for (const Array &lod_array : _clipmap_rids) {
+		for (const Array &mesh_array : lod_array) {
+			for (const RID &rid : mesh_array) {
+				instances.push_back(rid);
+			}
+		}
+	}
+	for (const std::pair<const uint64_t, CdlodPatch> &entry : _cdlod_patches) {
+		instances.push_back(entry.second.instance);
+	}
+	return instances;
+}
+
+Vector3 Terrain3DMesher::_get_target_position() const {
+	if (_viewpoint) {
+		if (Node3D *target = _viewpoint_target.get_target()) {
+			return target->get_global_position();
+		}
+	}
+	return _terrain->get_clipmap_target_position();
+}
+
+// Returns the distance between vertices of the LOD
+real_t Terrain3DMesher::_get_lod_spacing(const int p_lod) const {
+	return pow(2.f, real_t(p_lod)) * _vertex_spacing / pow(2.f, real_t(_tessellation_level));
+}
+
+uint64_t Terrain3DMesher::_get_node_key(const int p_lod, const Vector2i &p_node) {
+	return (uint64_t(p_lod) << 58) | ((uint64_t(uint32_t(p_node.x)) & 0x1FFFFFFFu) << 29) | (uint64_t(uint32_t(p_node.y)) & 0x1FFFFFFFu);
+}
+
+// Adds the tiles to draw for a quadtree node. Nodes within range of the next finer LOD are split
+// into their four children. Nodes outside of the frustum are skipped.
+void Terrain3DMesher::_select_cdlod_node(const int p_lod, const Vector2i &p_node, const Vector3 &p_target_pos,
+		const TypedArray<Plane> &p_frustum, std::vector<std::pair<int, Vector2i>> &r_selected) {
+	const real_t lod_spacing = _get_lod_spacing(p_lod);
+	const real_t size = lod_spacing * _mesh_size;
+	const Rect2 footprint = Rect2(Vector2(p_node) * size, V2(size));
+	const uint64_t key = _get_node_key(p_lod, p_node);
+	auto bounds_it = _cdlod_bounds.find(key);
+	Vector2 range;
+	if (bounds_it != _cdlod_bounds.end()) {
+		range = bounds_it->second.range;
+	} else {
+		range = _terrain->get_data() ? _get_cull_range(footprint, lod_spacing) : V2_ZERO;
+		_cdlod_bounds[key] = { footprint, range };
+	}
+	const AABB aabb = AABB(Vector3(footprint.position.x, range.x, footprint.position.y), Vector3(size, range.y - range.x, size));
+	for (int i = 0; i < p_frustum.size(); i++) {
+		const Plane plane = p_frustum[i];
+		// Frustum planes face out. Skip the node if its corner furthest inside is outside
+		const Vector3 corner = Vector3(plane.normal.x > 0.f ? aabb.position.x : aabb.position.x + aabb.size.x,
+				plane.normal.y > 0.f ? aabb.position.y : aabb.position.y + aabb.size.y,
+				plane.normal.z > 0.f ? aabb.position.z : aabb.position.z + aabb.size.z);
+		if (plane.distance_to(corner) > 0.f) {
+			return;
+		}
+	}
+	if (_cull_empty && !_has_region(footprint, lod_spacing)) {
+		return;
+	}
+	if (p_lod > 0) {
+		const Vector3 closest = p_target_pos.clamp(aabb.position, aabb.get_end());
+		if (p_target_pos.distance_to(closest) < _get_cdlod_range(p_lod - 1)) {
+			for (int z = 0; z < 2; z++) {
+				for (int x = 0; x < 2; x++) {
+					_select_cdlod_node(p_lod - 1, p_node * 2 + Vector2i(x, z), p_target_pos, p_frustum, r_selected);
+				}
+			}
+			return;
+		}
+	}
+	r_selected.push_back({ p_lod, p_node });
+}
+
+// Selects the quadtree tiles around the target, reusing the instances of tiles that remain
+// selected and hiding the rest for reuse.
+void Terrain3DMesher::_snap_cdlod(const Vector3 &p_target_pos) {
+	// Frustum culling would remove the shadows of tiles outside of the view, and with
+	// tessellation, snap only runs when the target moves
+	Camera3D *camera = _viewpoint ? Object::cast_to<Camera3D>(_viewpoint_target.get_target()) : _terrain->get_camera();
+	const bool cull = camera && camera->is_inside_tree() && _tessellation_level == 0 &&
+			_terrain->get_cast_shadows() == RenderingServer::SHADOW_CASTING_SETTING_OFF;
+	const Transform3D view = cull ? camera->get_global_transform() : Transform3D();
+	if (!_cdlod_dirty && p_target_pos == _cdlod_last_target && view == _cdlod_last_view) {
+		return;
+	}
+	_cdlod_dirty = false;
+	_cdlod_last_target = p_target_pos;
+	_cdlod_last_view = view;
+	TypedArray<Plane> frustum;
+	if (cull) {
+		frustum = camera->get_frustum();
+	}
+
+	// Roots are the nodes of the coarsest LOD within its range of the target
+	const int root_lod = _lods + _tessellation_level - 1;
+	const real_t root_size = _get_lod_spacing(root_lod) * _mesh_size;
+	const Vector2 root_range = V2(_get_cdlod_range(root_lod));
+	const Vector2 target_pos_2d = v3v2(p_target_pos);
+	const Vector2i start = Vector2i(((target_pos_2d - root_range) / root_size).floor());
+	const Vector2i end = Vector2i(((target_pos_2d + root_range) / root_size).floor());
+	// Forget the bounds of nodes the target has left behind, so the cache only spans the current roots
+	const Rect2 roots = Rect2(Vector2(start) * root_size, Vector2(end - start + V2I(1)) * root_size);
+	for (auto it = _cdlod_bounds.begin(); it != _cdlod_bounds.end();) {
+		it = roots.encloses(it->second.footprint) ? std::next(it) : _cdlod_bounds.erase(it);
+	}
+	std::vector<std::pair<int, Vector2i>> selected;
+	for (int z = start.y; z <= end.y; z++) {
+		for (int x = start.x; x <= end.x; x++) {
+			_select_cdlod_node(root_lod, Vector2i(x, z), p_target_pos, frustum, selected);
+		}
+	}
+
+	const bool visible = _terrain->is_visible_in_tree();
+	int calls = 0;
+	std::unordered_map<uint64_t, CdlodPatch> patches;
+	patches.reserve(selected.size());
+	for (const std::pair<int, Vector2i> &node : selected) {
+		const uint64_t key = _get_node_key(node.first, node.second);
+		auto it = _cdlod_patches.find(key);
+		if (it != _cdlod_patches.end()) {
+			patches[key] = it->second;
+			_cdlod_patches.erase(it);
+			continue;
+		}
+		CdlodPatch patch;
+		patch.lod_spacing = _get_lod_spacing(node.first);
+		const real_t size = patch.lod_spacing * _mesh_size;
+		patch.footprint = Rect2(Vector2(node.second) * size, V2(size));
+		if (_cdlod_pool.empty()) {
+			patch.instance = RS->instance_create2(_mesh_rids[TILE], _scenario);
+			_update_instance(patch.instance, visible);
+			calls += 8;
+		} else {
+			patch.instance = _cdlod_pool.back();
+			_cdlod_pool.pop_back();
+			RS->instance_set_visible(patch.instance, visible);
+			calls++;
+		}
+		Transform3D t = Transform3D().scaled(Vector3(patch.lod_spacing, 1.f, patch.lod_spacing));
+		t.origin = Vector3(patch.footprint.position.x, 0.f, patch.footprint.position.y);
+		RS->instance_set_transform(patch.instance, t);
+		RS->instance_teleport(patch.instance);
+		_update_instance_aabb(patch.instance, patch.footprint, patch.lod_spacing);
+		calls += 3;
+		patches[key] = patch;
+	}
+	// Tiles no longer selected
+	for (const std::pair<const uint64_t, CdlodPatch> &entry : _cdlod_patches) {
+		RS->instance_set_visible(entry.second.instance, false);
+		_cdlod_pool.push_back(entry.second.instance);
+		calls++;
+	}
+	_cdlod_patches = std::move(patches);
+	if (_viewpoint) {
+		const Vector4 clipmap_target = Vector4(p_target_pos.x, p_target_pos.y, p_target_pos.z, 1.f);
+		for (const std::pair<const uint64_t, CdlodPatch> &entry : _cdlod_patches) {
+			RS->instance_geometry_set_shader_parameter(entry.second.instance, "_clipmap_target", clipmap_target);
+			calls++;
+		}
+	}
+	_snap_calls = calls;
+	LOG(EXTREME, "Selected ", _cdlod_patches.size(), " CDLOD tiles with ", calls, " RenderingServer calls");
+}
+
 ///////////////////////////
 // Public Functions
 ///////////////////////////
 
 void Terrain3DMesher::initialize(Terrain3D *p_terrain, const int p_mesh_size, const int p_lods, const int p_tessellation_level,
-		const real_t p_vertex_spacing, const RID &p_material, const uint32_t p_render_layers) {
+		const real_t p_vertex_spacing, const RID &p_material, const uint32_t p_render_layers, const bool p_multimesh) {
 	if (p_terrain) {
 		_terrain = p_terrain;
 	} else {
@@ -297,6 +705,34 @@ void Terrain3DMesher::initialize(Terrain3D *p_terrain, const int p_mesh_size, co
 	_mesh_size = p_mesh_size;
 	_vertex_spacing = p_vertex_spacing;
 	_render_layers = p_render_layers;
+	_multimesh = p_multimesh;
+	_generate_clipmap();
+	update();
+	update_aabbs();
+	reset_target_position();
+	snap();
+}
+
+// Sets up a clipmap ring for an additional viewpoint, such as a split screen or minimap camera. It
+// uses the settings of the main mesher, which must be initialized first, and is drawn on this
+// mesher's render layers only.
+void Terrain3DMesher::initialize_viewpoint(const Terrain3DMesher *p_main) {
+	if (!p_main || !p_main->_terrain || p_main->_mesh_rids.is_empty()) {
+		return;
+	}
+	LOG(INFO, "Initializing clipmap ring for viewpoint: ", _viewpoint_target.get_target());
+	destroy();
+	_viewpoint = true;
+	_terrain = p_main->_terrain;
+	_scenario = p_main->_scenario;
+	_material = p_main->_material;
+	_lods = p_main->_lods;
+	_tessellation_level = p_main->_tessellation_level;
+	_mesh_size = p_main->_mesh_size;
+	_vertex_spacing = p_main->_vertex_spacing;
+	_multimesh = p_main->_multimesh;
+	_cdlod = p_main->_cdlod;
+	_cdlod_lod_distance = p_main->_cdlod_lod_distance;
 	_generate_clipmap();
 	update();
 	update_aabbs();
@@ -314,14 +750,49 @@ void Terrain3DMesher::destroy() {
 	_edge_pos.clear();
 	_fill_a_pos.clear();
 	_fill_b_pos.clear();
+	_lod_snaps.clear();
+}
+
+void Terrain3DMesher::set_viewpoint_target(Node3D *p_target) {
+	_viewpoint = true;
+	_viewpoint_target.set_target(p_target);
+}
+
+// Forces the next snap to reposition every LOD
+void Terrain3DMesher::reset_target_position() {
+	_last_target_position = V2_MAX;
+	_last_material_target = V3_MAX;
+	_lod_snaps.clear();
+	_cdlod_dirty = true;
+}
+
+void Terrain3DMesher::reset_update_stats() {
+	_target_updates = 0;
+	_target_updates_skipped = 0;
 }
 
 void Terrain3DMesher::snap() {
 	IS_INIT(VOID);
-	// Always update target position in shader
-	Vector3 target_pos = _terrain->get_clipmap_target_position();
-	if (_material.is_valid()) {
-		RS->material_set_param(_material, "_target_pos", target_pos);
+	// Resnap everything when the world background or height bounds change whether empty areas are culled
+	const bool cull_empty = _is_culling_empty();
+	if (cull_empty != _cull_empty) {
+		_cull_empty = cull_empty;
+		reset_target_position();
+	}
+	// Update target position in shader when it moves
+	Vector3 target_pos = _get_target_position();
+	if (_material.is_valid() && !_viewpoint) {
+		if (target_pos != _last_material_target) {
+			_last_material_target = target_pos;
+			RS->material_set_param(_material, "_target_pos", target_pos);
+			_target_updates++;
+		} else {
+			_target_updates_skipped++;
+		}
+	}
+	if (_cdlod) {
+		_snap_cdlod(target_pos);
+		return;
 	}
 	// If clipmap target hasn't moved enough, skip
 	Vector2 target_pos_2d = v3v2(target_pos);
@@ -333,17 +804,27 @@ void Terrain3DMesher::snap() {
 
 	// Recenter terrain on the target
 	_last_target_position = target_pos_2d;
+	int calls = 0;
+	if (_viewpoint) {
+		const Vector4 clipmap_target = Vector4(target_pos.x, target_pos.y, target_pos.z, 1.f);
+		for (const RID &rid : _get_instances()) {
+			RS->instance_geometry_set_shader_parameter(rid, "_clipmap_target", clipmap_target);
+			calls++;
+		}
+	}
 	Vector3 snapped_pos = (target_pos / vertex_spacing).floor() * vertex_spacing;
 	Vector3 pos = V3_ZERO;
-	for (int lod = 0; lod < _clipmap_rids.size(); ++lod) {
+	_lod_snaps.resize(_instance_counts.size());
+	_footprints.resize(_instance_counts.size());
+	const bool visible = _terrain->is_visible_in_tree();
+	for (int lod = 0; lod < int(_instance_counts.size()); ++lod) {
 		real_t snap_step = pow(2.f, lod + 1.f) * vertex_spacing;
 		Vector3 lod_scale = Vector3(pow(2.f, lod) * vertex_spacing, 1.f, pow(2.f, lod) * vertex_spacing);
 
 		// Snap pos.xz
-		pos.x = round(snapped_pos.x / snap_step) * snap_step;
-		pos.z = round(snapped_pos.z / snap_step) * snap_step;
-
-		LOG(EXTREME, "Snapping clipmap LOD", lod, " to position: ", pos);
+		Vector2i grid = Vector2i(int32_t(round(snapped_pos.x / snap_step)), int32_t(round(snapped_pos.z / snap_step)));
+		pos.x = real_t(grid.x) * snap_step;
+		pos.z = real_t(grid.y) * snap_step;
 
 		// test_x and test_z for edge strip positions
 		real_t next_snap_step = pow(2.f, lod + 2.f) * vertex_spacing;
@@ -351,10 +832,29 @@ void Terrain3DMesher::snap() {
 		real_t next_z = round(snapped_pos.z / next_snap_step) * next_snap_step;
 		int test_x = CLAMP(int(round((pos.x - next_x) / snap_step)) + 1, 0, 2);
 		int test_z = CLAMP(int(round((pos.z - next_z) / snap_step)) + 1, 0, 2);
-		Array lod_array = _clipmap_rids[lod];
-		for (int mesh = 0; mesh < lod_array.size(); ++mesh) {
-			Array mesh_array = lod_array[mesh];
-			for (int instance = 0; instance < mesh_array.size(); ++instance) {
+
+		// Coarser LODs move less often. Skip those whose instances would land in the same place
+		LodSnap &lod_snap = _lod_snaps[lod];
+		if (lod_snap.grid == grid && lod_snap.test_x == test_x && lod_snap.test_z == test_z) {
+			continue;
+		}
+		lod_snap = { grid, test_x, test_z };
+		LOG(EXTREME, "Snapping clipmap LOD", lod, " to position: ", pos);
+		Array lod_array;
+		if (!_multimesh) {
+			lod_array = _clipmap_rids[lod];
+		}
+		const std::vector<int> &counts = _instance_counts[lod];
+		std::vector<Rect2> &footprints = _footprints[lod];
+		footprints.clear();
+		for (int mesh = 0; mesh < int(counts.size()); ++mesh) {
+			Array mesh_array;
+			if (!_multimesh) {
+				mesh_array = lod_array[mesh];
+			}
+			const MeshType type = _get_mesh_type(lod, mesh);
+			const Vector2 mesh_size = Vector2(_mesh_sizes[type]);
+			for (int instance = 0; instance < counts[mesh]; ++instance) {
 				Transform3D t = Transform3D();
 				switch (mesh) {
 					case TILE: {
@@ -396,11 +896,46 @@ void Terrain3DMesher::snap() {
 				}
 				t = t.scaled(lod_scale);
 				t.origin += pos;
+				const Rect2 footprint = Rect2(v3v2(t.origin), mesh_size * lod_scale.x);
+				footprints.push_back(footprint);
+				const bool empty = _cull_empty && !_has_region(footprint, lod_scale.x);
+				if (_multimesh) {
+					// Collapse empty instances so they draw no triangles
+					if (empty) {
+						t.basis = Basis(V3_ZERO, V3_ZERO, V3_ZERO);
+					}
+					// Rows of the 3x4 transform
+					MultiMeshType &mm = _multimeshes[type];
+					float *w = mm.buffer.ptrw() + (_multimesh_offsets[lod][mesh] + instance) * MULTIMESH_STRIDE;
+					write_multimesh_transform(w, t);
+					mm.dirty = true;
+					continue;
+				}
 				RS->instance_set_transform(mesh_array[instance], t);
 				RS->instance_teleport(mesh_array[instance]);
+				calls += 2;
+				calls += _set_instance_empty(mesh_array[instance], empty, visible);
+				if (_use_height_bounds) {
+					_update_instance_aabb(mesh_array[instance], footprint, lod_scale.x);
+					calls++;
+				}
 			}
 		}
 	}
+	// Upload each changed MultiMesh once
+	for (int type = 0; type < int(_multimeshes.size()); type++) {
+		MultiMeshType &mm = _multimeshes[type];
+		if (!mm.dirty) {
+			continue;
+		}
+		mm.dirty = false;
+		RS->multimesh_set_buffer(mm.multimesh, mm.buffer);
+		_update_multimesh_aabb(type);
+		RS->instance_teleport(mm.instance);
+		calls += 3;
+	}
+	_snap_calls = calls;
+	LOG(EXTREME, "Clipmap snap made ", calls, " RenderingServer calls");
 	return;
 }
 
@@ -411,6 +946,19 @@ void Terrain3DMesher::update() {
 		LOG(DEBUG, "Terrain3D's world3D is null");
 		return;
 	}
+	const bool visible = _terrain->is_visible_in_tree();
+	LOG(INFO, "Updating all mesh instances for ", _instance_counts.size(), " LODs");
+	for (const RID &rid : _get_instances()) {
+		_update_instance(rid, visible && _empty_instances.count(rid.get_id()) == 0);
+	}
+	for (const RID &rid : _cdlod_pool) {
+		_update_instance(rid, false);
+	}
+	return;
+}
+
+// Applies the terrain's rendering settings to the instance.
+void Terrain3DMesher::_update_instance(const RID &p_instance, const bool p_visible) const {
 	bool baked_light;
 	bool dynamic_gi;
 	switch (_terrain->get_gi_mode()) {
@@ -430,30 +978,23 @@ void Terrain3DMesher::update() {
 	}
 
 	RenderingServer::ShadowCastingSetting cast_shadows = _terrain->get_cast_shadows();
-	bool visible = _terrain->is_visible_in_tree();
-
-	LOG(INFO, "Updating all mesh instances for ", _clipmap_rids.size(), " LODs");
-	for (const Array &lod_array : _clipmap_rids) {
-		for (const Array &mesh_array : lod_array) {
-			for (const RID &rid : mesh_array) {
-				RS->instance_set_visible(rid, visible);
-				RS->instance_set_scenario(rid, _scenario);
-				RS->instance_set_layer_mask(rid, _render_layers);
-				RS->instance_geometry_set_cast_shadows_setting(rid, cast_shadows);
-				RS->instance_geometry_set_flag(rid, RenderingServer::INSTANCE_FLAG_USE_BAKED_LIGHT, baked_light);
-				RS->instance_geometry_set_flag(rid, RenderingServer::INSTANCE_FLAG_USE_DYNAMIC_GI, dynamic_gi);
-			}
-		}
-	}
-	return;
+	RS->instance_geometry_set_material_override(p_instance, _material);
+	RS->instance_set_visible(p_instance, p_visible);
+	RS->instance_set_scenario(p_instance, _scenario);
+	RS->instance_set_layer_mask(p_instance, _render_layers);
+	RS->instance_geometry_set_cast_shadows_setting(p_instance, cast_shadows);
+	RS->instance_geometry_set_flag(p_instance, RenderingServer::INSTANCE_FLAG_USE_BAKED_LIGHT, baked_light);
+	RS->instance_geometry_set_flag(p_instance, RenderingServer::INSTANCE_FLAG_USE_DYNAMIC_GI, dynamic_gi);
 }
 
-// Iterates over all meshes and updates their AABBs
-// All instances of each mesh inherit the updated AABB
+// Iterates over all instances and updates their AABBs. Meshes are shared between meshers, so
+// AABBs are set on the instances rather than the meshes
 // Defaults to using the terrain parameters
-void Terrain3DMesher::update_aabbs(const real_t p_cull_margin, const Vector2 &p_height_range) {
+// p_area: If it has an area, only the heights within this world XZ area have changed, so only the
+//  instances over it are updated.
+void Terrain3DMesher::update_aabbs(const real_t p_cull_margin, const Vector2 &p_height_range, const Rect2 &p_area) {
 	IS_DATA_INIT(VOID);
-	LOG(INFO, "Updating ", _mesh_rids.size(), " meshes AABBs")
+	LOG(INFO, "Updating clipmap instance AABBs")
 	real_t cull_margin;
 	Vector2 height_range;
 	if (p_cull_margin < 0.f) {
@@ -467,11 +1008,76 @@ void Terrain3DMesher::update_aabbs(const real_t p_cull_margin, const Vector2 &p_
 		height_range = p_height_range;
 	}
 	height_range.y += std::abs(height_range.x);
-	for (const RID &rid : _mesh_rids) {
-		AABB aabb = RS->mesh_get_custom_aabb(rid);
-		aabb.position.y = height_range.x - cull_margin;
-		aabb.size.y = height_range.y + cull_margin * 2.f;
-		RS->mesh_set_custom_aabb(rid, aabb);
+	_height_range = Vector2(height_range.x - cull_margin, height_range.x + height_range.y + cull_margin);
+
+	// Instances over the terrain get their own AABBs from the heights below them. Others, like the ocean,
+	// span the full height range
+	_cull_margin = cull_margin;
+	_use_height_bounds = p_height_range.x == FLT_MAX;
+	const bool use_area = _use_height_bounds && p_area.has_area();
+	// Footprint bounds include the next vertex at their LOD spacing
+	auto overlaps = [&](const Rect2 &p_footprint, const real_t p_lod_spacing) -> bool {
+		return !use_area || p_footprint.grow(p_lod_spacing).intersects(p_area, true);
+	};
+	if (_cdlod) {
+		// Heights changed, so reselect tiles with new node bounds
+		if (use_area) {
+			for (auto it = _cdlod_bounds.begin(); it != _cdlod_bounds.end();) {
+				const real_t lod_spacing = _get_lod_spacing(int(it->first >> 58));
+				it = overlaps(it->second.footprint, lod_spacing) ? _cdlod_bounds.erase(it) : std::next(it);
+			}
+		} else {
+			_cdlod_bounds.clear();
+		}
+		_cdlod_dirty = true;
+		for (const std::pair<const uint64_t, CdlodPatch> &entry : _cdlod_patches) {
+			if (overlaps(entry.second.footprint, entry.second.lod_spacing)) {
+				_update_instance_aabb(entry.second.instance, entry.second.footprint, entry.second.lod_spacing);
+			}
+		}
+		return;
+	}
+	if (_multimesh) {
+		for (int type = 0; type < int(_multimeshes.size()); type++) {
+			_update_multimesh_aabb(type);
+		}
+		// Regions may have changed, so rewrite the buffers with empty instances collapsed. Edits don't
+		// change regions.
+		if (_cull_empty && !use_area) {
+			reset_target_position();
+		}
+		return;
+	}
+	if (!_use_height_bounds) {
+		for (int lod = 0; lod < _clipmap_rids.size(); lod++) {
+			const Array lod_array = _clipmap_rids[lod];
+			for (int mesh = 0; mesh < lod_array.size(); mesh++) {
+				const Vector2i size = _mesh_sizes[_get_mesh_type(lod, mesh)];
+				const AABB aabb = AABB(Vector3(0.f, _height_range.x, 0.f), Vector3(size.x, _height_range.y - _height_range.x, size.y));
+				const Array mesh_array = lod_array[mesh];
+				for (const RID &rid : mesh_array) {
+					RS->instance_set_custom_aabb(rid, aabb);
+				}
+			}
+		}
+		return;
+	}
+	const bool visible = _terrain->is_visible_in_tree();
+	for (int lod = 0; lod < _clipmap_rids.size() && lod < int(_footprints.size()); lod++) {
+		const Array lod_array = _clipmap_rids[lod];
+		const std::vector<Rect2> &footprints = _footprints[lod];
+		const real_t lod_spacing = pow(2.f, lod) * _vertex_spacing / pow(2.f, _tessellation_level);
+		size_t index = 0;
+		for (const Array &mesh_array : lod_array) {
+			for (const RID &rid : mesh_array) {
+				if (index < footprints.size() && overlaps(footprints[index], lod_spacing)) {
+					_update_instance_aabb(rid, footprints[index], lod_spacing);
+					// Regions may have been added or removed
+					_set_instance_empty(rid, _cull_empty && !_has_region(footprints[index], lod_spacing), visible);
+				}
+				index++;
+			}
+		}
 	}
 	return;
 }
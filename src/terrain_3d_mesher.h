@@ -3,7 +3,13 @@
 #ifndef TERRAIN3D_MESHER_CLASS_H
 #define TERRAIN3D_MESHER_CLASS_H
 
+#include <godot_cpp/classes/camera3d.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "constants.h"
+#include "target_node_3d.h"
 
 class Terrain3D;
 
@@ -24,14 +30,91 @@ public: // Constants
 		STANDARD_EDGE_B,
 	};
 
+	// Mesh types used by LOD0 instances, by instance array index. LOD0 has trims in place of fills
+	static inline const MeshType LOD0_TYPES[] = {
+		STANDARD_TILE,
+		STANDARD_EDGE_A,
+		STANDARD_EDGE_B,
+		STANDARD_TRIM_A,
+		STANDARD_TRIM_B,
+	};
+
+	static inline const int MULTIMESH_STRIDE = 12; // Floats per MultiMesh instance: 3x4 transform
+
 private:
+	// Clipmap meshes depend only on their size and grid type, so all meshers share them. Materials
+	// and AABBs are set on instances. Keyed by _get_mesh_key()
+	struct CachedMesh {
+		RID mesh;
+		int refs = 0;
+	};
+	static inline std::unordered_map<uint64_t, CachedMesh> _mesh_cache;
+
 	Terrain3D *_terrain = nullptr;
 	RID _scenario = RID();
+	// Additional viewpoint rings follow their own target
+	bool _viewpoint = false;
+	TargetNode3D _viewpoint_target;
 	Vector2 _last_target_position = V2_MAX;
+	// Snapped grid position and edge placement of each LOD, so only LODs that moved are updated
+	struct LodSnap {
+		Vector2i grid = V2I_MAX;
+		int test_x = -1;
+		int test_z = -1;
+	};
+	std::vector<LodSnap> _lod_snaps;
+	int _snap_calls = 0; // RenderingServer calls made by the last snap that moved the clipmap
+	Vector3 _last_material_target = V3_MAX; // Last _target_pos sent to the material
+	uint64_t _target_updates = 0;
+	uint64_t _target_updates_skipped = 0;
 
 	Array _mesh_rids;
+	std::vector<Vector2i> _mesh_sizes; // Quads per side of each mesh type
 	// LODs -> MeshTypes -> Instances
 	Array _clipmap_rids;
+	// World XZ footprint of each instance, LODs -> flattened MeshTypes and Instances, for per instance AABBs
+	std::vector<std::vector<Rect2>> _footprints;
+	bool _use_height_bounds = false; // Fit instance AABBs to the terrain heights below them
+	real_t _cull_margin = 0.f;
+	Vector2 _height_range = V2_ZERO; // Min and max Y of the mesh AABBs, including margins
+	// With no world background, instances over areas without regions are hidden
+	bool _cull_empty = false;
+	std::unordered_set<uint64_t> _empty_instances; // Hidden instance RID ids
+	// LODs -> MeshTypes -> instance count. Used to iterate instances in both modes
+	std::vector<std::vector<int>> _instance_counts;
+
+	// MultiMesh mode draws all instances of each mesh type with one MultiMesh instead of one instance each
+	bool _multimesh = false;
+	struct MultiMeshType {
+		RID multimesh;
+		RID instance;
+		PackedFloat32Array buffer;
+		int count = 0;
+		bool dirty = false;
+	};
+	std::vector<MultiMeshType> _multimeshes; // By MeshType
+	// LODs -> MeshTypes -> index of the first instance in its MultiMesh
+	std::vector<std::vector<int>> _multimesh_offsets;
+
+	// CDLOD mode draws a quadtree of tiles selected around the target on each snap. Tiles morph to the
+	// next LOD by distance in the shader instead of snapping in rings
+	bool _cdlod = false;
+	real_t _cdlod_lod_distance = 3.f; // LOD ranges, in tiles of that LOD
+	struct CdlodPatch {
+		RID instance;
+		Rect2 footprint;
+		real_t lod_spacing = 0.f;
+	};
+	std::unordered_map<uint64_t, CdlodPatch> _cdlod_patches; // Visible tiles by node key
+	std::vector<RID> _cdlod_pool; // Hidden instances for reuse
+	struct CdlodBounds {
+		Rect2 footprint;
+		Vector2 range;
+	};
+	std::unordered_map<uint64_t, CdlodBounds> _cdlod_bounds; // Cull range of visited nodes within the roots by node key
+	bool _cdlod_dirty = true;
+	Vector3 _cdlod_last_target = V3_MAX;
+	Transform3D _cdlod_last_view;
 
 	// Mesh offset data
 	// LOD0 only
@@ -56,10 +139,31 @@ private:
 	uint32_t _render_layers = 1u; // Bit 1 only
 
 	void _generate_mesh_types();
+	static uint64_t _get_mesh_key(const Vector2i &p_size, const bool p_standard_grid);
+	RID _acquire_mesh(const Vector2i &p_size, const bool p_standard_grid = false);
+	void _release_mesh(const RID &p_mesh);
 	RID _generate_mesh(const Vector2i &p_size, const bool p_standard_grid = false);
 	RID _instantiate_mesh(const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices, const AABB &p_aabb);
 	void _generate_clipmap();
 	void _generate_offset_data();
+	MeshType _get_mesh_type(const int p_lod, const int p_mesh) const { return p_lod == 0 ? LOD0_TYPES[p_mesh] : MeshType(p_mesh); }
+	Vector2 _get_height_bounds(const Rect2 &p_footprint, const real_t p_lod_spacing) const;
+	Vector2 _get_cull_range(const Rect2 &p_footprint, const real_t p_lod_spacing) const;
+	void _update_instance_aabb(const RID &p_instance, const Rect2 &p_footprint, const real_t p_lod_spacing) const;
+	void _update_multimesh_aabb(const int p_type) const;
+	bool _is_culling_empty() const;
+	bool _has_region(const Rect2 &p_footprint, const real_t p_lod_spacing) const;
+	int _set_instance_empty(const RID &p_instance, const bool p_empty, const bool p_visible);
+	std::vector<RID> _get_instances() const;
+	void _update_instance(const RID &p_instance, const bool p_visible) const;
+	Vector3 _get_target_position() const;
+
+	real_t _get_lod_spacing(const int p_lod) const;
+	real_t _get_cdlod_range(const int p_lod) const { return _cdlod_lod_distance * _mesh_size * _get_lod_spacing(p_lod); }
+	static uint64_t _get_node_key(const int p_lod, const Vector2i &p_node);
+	void _select_cdlod_node(const int p_lod, const Vector2i &p_node, const Vector3 &p_target_pos,
+			const TypedArray<Plane> &p_frustum, std::vector<std::pair<int, Vector2i>> &r_selected);
+	void _snap_cdlod(const Vector3 &p_target_pos);
 
 	void _clear_clipmap();
 	void _clear_mesh_types();
@@ -69,13 +173,18 @@ public:
 	~Terrain3DMesher() { destroy(); }
 
 	void initialize(Terrain3D *p_terrain, const int p_mesh_size, const int p_lods, const int p_tessellation_level,
-			const real_t p_vertex_spacing, const RID &p_material, const uint32_t p_render_layers);
+			const real_t p_vertex_spacing, const RID &p_material, const uint32_t p_render_layers, const bool p_multimesh = false);
+	void initialize_viewpoint(const Terrain3DMesher *p_main);
 	void destroy();
 
 	void snap();
-	void reset_target_position() { _last_target_position = V2_MAX; }
+	void reset_target_position();
+	int get_snap_calls() const { return _snap_calls; }
+	uint64_t get_target_updates() const { return _target_updates; }
+	uint64_t get_target_updates_skipped() const { return _target_updates_skipped; }
+	void reset_update_stats();
 	void update();
-	void update_aabbs(const real_t p_cull_margin = -1.f, const Vector2 &p_height_range = V2_MAX);
+	void update_aabbs(const real_t p_cull_margin = -1.f, const Vector2 &p_height_range = V2_MAX, const Rect2 &p_area = Rect2());
 
 	void set_material(const RID &p_material) { _material = p_material; }
 	RID get_material() const { return _material; }
@@ -89,6 +198,14 @@ public:
 	real_t get_vertex_spacing() const { return _vertex_spacing; }
 	void set_render_layers(const uint32_t p_layers) { _render_layers = p_layers; }
 	uint32_t get_render_layers() const { return _render_layers; }
+	bool is_multimesh() const { return _multimesh; }
+	void set_cdlod(const bool p_enabled) { _cdlod = p_enabled; }
+	bool is_cdlod() const { return _cdlod; }
+	void set_cdlod_lod_distance(const real_t p_distance) { _cdlod_lod_distance = p_distance; }
+	real_t get_cdlod_lod_distance() const { return _cdlod_lod_distance; }
+	void set_viewpoint_target(Node3D *p_target);
+	Node3D *get_viewpoint_target() const { return _viewpoint_target.get_target(); }
+	bool is_viewpoint() const { return _viewpoint; }
 };
 // Inline Functions
 
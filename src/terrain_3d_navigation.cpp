@@ -0,0 +1,348 @@
+// Copyright © 2023-2026 Cory Petkovsek, Roope Palmroos, and Contributors.
+
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/navigation_mesh_source_geometry_data3d.hpp>
+#include <godot_cpp/classes/navigation_server3d.hpp>
+#include <godot_cpp/classes/world3d.hpp>
+#include <algorithm>
+#include <vector>
+
+#include "constants.h"
+#include "logger.h"
+#include "terrain_3d.h"
+#include "terrain_3d_navigation.h"
+#include "terrain_3d_util.h"
+
+///////////////////////////
+// Private Functions
+///////////////////////////
+
+Vector2i Terrain3DNavigation::_get_tile(const Vector3 &p_global_position) const {
+	return Vector2i(Math::floor(p_global_position.x / _tile_size), Math::floor(p_global_position.z / _tile_size));
+}
+
+// Tile footprint in world space, spanning the full terrain height plus room for agents to stand on top
+AABB Terrain3DNavigation::_get_tile_aabb(const Vector2i &p_tile) const {
+	IS_DATA_INIT(AABB());
+	const Vector2 height_range = _terrain->get_data()->get_height_range();
+	const real_t agent_height = _template.is_valid() ? _template->get_agent_height() : 1.5f;
+	const real_t bottom = height_range.x - 1.f;
+	const real_t top = height_range.y + agent_height + 1.f;
+	return AABB(Vector3(p_tile.x * _tile_size, bottom, p_tile.y * _tile_size),
+			Vector3(_tile_size, top - bottom, _tile_size));
+}
+
+// Source geometry is gathered this far beyond each tile, so agent_radius erosion doesn't open gaps
+// between tiles. Snapped up to the cell size so tile edges line up.
+real_t Terrain3DNavigation::_get_border_size() const {
+	const real_t cell_size = _template.is_valid() ? _template->get_cell_size() : 0.25f;
+	real_t border = 0.f;
+	if (_template.is_valid()) {
+		border = _template->get_border_size() > 0.f ? _template->get_border_size() : _template->get_agent_radius();
+	} else {
+		border = 0.5f;
+	}
+	return Math::ceil(border / cell_size) * cell_size;
+}
+
+// Frees tiles out of range and creates navigation regions for new tiles around p_center
+void Terrain3DNavigation::_update_tiles(const Vector2i &p_center) {
+	const int tile_radius = int(Math::ceil(_radius / _tile_size));
+	// Keep one extra ring so moving back and forth over a tile edge doesn't rebake
+	for (auto it = _tiles.begin(); it != _tiles.end();) {
+		const Vector2i offset = (it->first - p_center).abs();
+		if (MAX(offset.x, offset.y) > tile_radius + 1) {
+			LOG(EXTREME, "Freeing navigation tile ", it->first);
+			_free_tile(it->second);
+			it = _tiles.erase(it);
+		} else {
+			++it;
+		}
+	}
+	const RID map = _terrain->get_world_3d()->get_navigation_map();
+	for (int z = -tile_radius; z <= tile_radius; z++) {
+		for (int x = -tile_radius; x <= tile_radius; x++) {
+			const Vector2i loc = p_center + Vector2i(x, z);
+			if (_tiles.count(loc) > 0) {
+				continue;
+			}
+			LOG(EXTREME, "Adding navigation tile ", loc);
+			Tile tile;
+			tile.version = ++_version_counter;
+			tile.region = NS->region_create();
+			NS->region_set_map(tile.region, map);
+			NS->region_set_navigation_layers(tile.region, _layers);
+			NS->region_set_owner_id(tile.region, _terrain->get_instance_id());
+			_tiles[loc] = tile;
+		}
+	}
+}
+
+// Gathers source geometry on this thread and hands it to the NavigationServer to bake in the background.
+// The gather blocks the physics frame, which is why update() starts at most MAX_BAKE_JOBS at a time.
+void Terrain3DNavigation::_bake_tile(const Vector2i &p_tile, Tile &r_tile) {
+	const AABB tile_aabb = _get_tile_aabb(p_tile);
+	const real_t border = _get_border_size();
+	const AABB source_aabb = tile_aabb.grow(border);
+
+	Ref<NavigationMeshSourceGeometryData3D> source;
+	source.instantiate();
+	const Array arrays = _terrain->generate_nav_mesh_source_arrays(source_aabb, _require_nav, 0.f, _instances);
+	if (PackedVector3Array(arrays[Mesh::ARRAY_VERTEX]).size() > 0) {
+		source->add_mesh_array(arrays, Transform3D());
+	}
+
+	Ref<NavigationMesh> nav_mesh;
+	if (_template.is_valid()) {
+		nav_mesh = _template->duplicate();
+	} else {
+		nav_mesh.instantiate();
+	}
+	if (!source->has_data()) {
+		LOG(EXTREME, "No navigation source geometry in tile ", p_tile);
+		NS->region_set_navigation_mesh(r_tile.region, nav_mesh);
+		r_tile.baked_version = r_tile.version;
+		return;
+	}
+	nav_mesh->set_filter_baking_aabb(tile_aabb);
+	nav_mesh->set_filter_baking_aabb_offset(V3_ZERO);
+	nav_mesh->set_border_size(border);
+	r_tile.baking_version = r_tile.version;
+	_active_jobs++;
+	LOG(EXTREME, "Baking navigation tile ", p_tile, " version ", r_tile.version);
+	// Bound by id, since this object may be freed before the bake finishes
+	NS->bake_from_source_geometry_data_async(nav_mesh, source,
+			callable_mp_static(&Terrain3DNavigation::_on_tile_baked_id).bind(get_instance_id(), p_tile, r_tile.version, nav_mesh));
+}
+
+// Forwards a finished bake to the object it was started by, if that still exists
+void Terrain3DNavigation::_on_tile_baked_id(const uint64_t p_instance_id, const Vector2i &p_tile, const uint32_t p_version,
+		const Ref<NavigationMesh> &p_nav_mesh) {
+	Terrain3DNavigation *navigation = Object::cast_to<Terrain3DNavigation>(ObjectDB::get_instance(p_instance_id));
+	if (!navigation) {
+		LOG(EXTREME, "Discarding navigation bake for tile ", p_tile, " of a freed object");
+		return;
+	}
+	navigation->_on_tile_baked(p_tile, p_version, p_nav_mesh);
+}
+
+// Called by the NavigationServer when a bake finishes. Tiles freed or rebuilt since are ignored.
+void Terrain3DNavigation::_on_tile_baked(const Vector2i &p_tile, const uint32_t p_version, const Ref<NavigationMesh> &p_nav_mesh) {
+	_active_jobs = MAX(_active_jobs - 1, 0);
+	auto it = _tiles.find(p_tile);
+	if (it == _tiles.end() || it->second.baking_version != p_version) {
+		LOG(EXTREME, "Discarding stale navigation bake for tile ", p_tile);
+		return;
+	}
+	Tile &tile = it->second;
+	tile.baking_version = 0;
+	tile.baked_version = p_version; // If edited meanwhile, the version has moved on and it bakes again
+	NS->region_set_navigation_mesh(tile.region, p_nav_mesh);
+	LOG(EXTREME, "Navigation tile ", p_tile, " baked, polygons: ", p_nav_mesh->get_polygon_count());
+}
+
+void Terrain3DNavigation::_free_tile(Tile &r_tile) {
+	if (r_tile.region.is_valid()) {
+		NS->free_rid(r_tile.region);
+		r_tile.region = RID();
+	}
+}
+
+///////////////////////////
+// Public Functions
+///////////////////////////
+
+void Terrain3DNavigation::initialize(Terrain3D *p_terrain) {
+	if (p_terrain) {
+		_terrain = p_terrain;
+	} else {
+		return;
+	}
+	build();
+}
+
+// Frees all tiles, then bakes tiles around the collision target over the following frames
+void Terrain3DNavigation::build() {
+	IS_DATA_INIT(VOID);
+	destroy();
+	if (!_enabled || IS_EDITOR) {
+		return;
+	}
+	if (!_terrain->is_inside_world()) {
+		LOG(ERROR, "Terrain isn't inside world. Returning.");
+		return;
+	}
+	LOG(INFO, "Building navigation tiles");
+	// The map must use the cell sizes tiles are baked with. It's shared, so only report a mismatch
+	const RID map = _terrain->get_world_3d()->get_navigation_map();
+	const real_t cell_size = _template.is_valid() ? _template->get_cell_size() : 0.25f;
+	const real_t cell_height = _template.is_valid() ? _template->get_cell_height() : 0.25f;
+	const real_t map_cell_size = NS->map_get_cell_size(map);
+	const real_t map_cell_height = NS->map_get_cell_height(map);
+	if (!Math::is_equal_approx(map_cell_size, cell_size) || !Math::is_equal_approx(map_cell_height, cell_height)) {
+		LOG(WARN, "Navigation map cell size ", map_cell_size, " and height ", map_cell_height,
+				" don't match the template's ", cell_size, " and ", cell_height,
+				". Set them in Project Settings > Navigation > 3D, or change the template");
+	}
+	_initialized = true;
+	update();
+}
+
+// Streams tiles around the collision target and starts bakes for new or edited tiles, nearest first.
+// Called every physics frame.
+void Terrain3DNavigation::update() {
+	IS_DATA_INIT(VOID);
+	if (!_initialized) {
+		return;
+	}
+	const Vector2i center = _get_tile(_terrain->get_collision_target_position());
+	if (center != _last_center) {
+		_last_center = center;
+		_update_tiles(center);
+	}
+	if (_active_jobs >= MAX_BAKE_JOBS) {
+		return;
+	}
+	std::vector<Vector2i> queue;
+	for (const std::pair<const Vector2i, Tile> &entry : _tiles) {
+		if (entry.second.baking_version == 0 && entry.second.baked_version != entry.second.version) {
+			queue.push_back(entry.first);
+		}
+	}
+	if (queue.empty()) {
+		return;
+	}
+	std::sort(queue.begin(), queue.end(), [&center](const Vector2i &a, const Vector2i &b) {
+		return (a - center).length_squared() < (b - center).length_squared();
+	});
+	for (const Vector2i &loc : queue) {
+		if (_active_jobs >= MAX_BAKE_JOBS) {
+			break;
+		}
+		_bake_tile(loc, _tiles[loc]);
+	}
+}
+
+// Marks tiles overlapping the area, plus their borders, for rebaking
+void Terrain3DNavigation::invalidate(const AABB &p_global_aabb) {
+	if (!_initialized) {
+		return;
+	}
+	const real_t border = _get_border_size();
+	const Vector2i start = _get_tile(p_global_aabb.position - Vector3(border, 0.f, border));
+	const Vector2i end = _get_tile(p_global_aabb.get_end() + Vector3(border, 0.f, border));
+	LOG(DEBUG, "Invalidating navigation tiles from ", start, " to ", end);
+	for (int z = start.y; z <= end.y; z++) {
+		for (int x = start.x; x <= end.x; x++) {
+			auto it = _tiles.find(Vector2i(x, z));
+			if (it != _tiles.end()) {
+				it->second.version = ++_version_counter;
+			}
+		}
+	}
+}
+
+// Rebakes all tiles, keeping the current navigation meshes until each finishes
+void Terrain3DNavigation::rebake() {
+	if (!_initialized) {
+		return;
+	}
+	LOG(DEBUG, "Marking all navigation tiles for rebaking");
+	for (std::pair<const Vector2i, Tile> &entry : _tiles) {
+		entry.second.version = ++_version_counter;
+	}
+}
+
+// Bakes still in progress finish in the background and are discarded
+void Terrain3DNavigation::destroy() {
+	_initialized = false;
+	_last_center = V2I_MAX;
+	if (!_tiles.empty()) {
+		LOG(INFO, "Freeing ", _tiles.size(), " navigation tiles");
+	}
+	for (std::pair<const Vector2i, Tile> &entry : _tiles) {
+		_free_tile(entry.second);
+	}
+	_tiles.clear();
+}
+
+void Terrain3DNavigation::set_enabled(const bool p_enabled) {
+	SET_IF_DIFF(_enabled, p_enabled);
+	LOG(INFO, "Setting navigation baking enabled: ", _enabled);
+	build();
+}
+
+void Terrain3DNavigation::set_template(const Ref<NavigationMesh> &p_template) {
+	SET_IF_DIFF(_template, p_template);
+	LOG(INFO, "Setting navigation template: ", _template);
+	build();
+}
+
+void Terrain3DNavigation::set_tile_size(const real_t p_size) {
+	SET_IF_DIFF(_tile_size, CLAMP(p_size, 8.f, 1024.f));
+	LOG(INFO, "Setting navigation tile size: ", _tile_size);
+	build();
+}
+
+void Terrain3DNavigation::set_radius(const real_t p_radius) {
+	SET_IF_DIFF(_radius, CLAMP(p_radius, 0.f, 8192.f));
+	LOG(INFO, "Setting navigation radius: ", _radius);
+	_last_center = V2I_MAX; // Update tiles on the next frame
+}
+
+void Terrain3DNavigation::set_layers(const uint32_t p_layers) {
+	SET_IF_DIFF(_layers, p_layers);
+	LOG(INFO, "Setting navigation layers: ", _layers);
+	for (const std::pair<const Vector2i, Tile> &entry : _tiles) {
+		NS->region_set_navigation_layers(entry.second.region, _layers);
+	}
+}
+
+void Terrain3DNavigation::set_require_nav(const bool p_require_nav) {
+	SET_IF_DIFF(_require_nav, p_require_nav);
+	LOG(INFO, "Setting navigation require nav: ", _require_nav);
+	rebake();
+}
+
+void Terrain3DNavigation::set_instances(const bool p_enabled) {
+	SET_IF_DIFF(_instances, p_enabled);
+	LOG(INFO, "Setting navigation instances: ", _instances);
+	rebake();
+}
+
+///////////////////////////
+// Protected Functions
+///////////////////////////
+
+void Terrain3DNavigation::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("build"), &Terrain3DNavigation::build);
+	ClassDB::bind_method(D_METHOD("update"), &Terrain3DNavigation::update);
+	ClassDB::bind_method(D_METHOD("invalidate", "global_aabb"), &Terrain3DNavigation::invalidate);
+	ClassDB::bind_method(D_METHOD("rebake"), &Terrain3DNavigation::rebake);
+	ClassDB::bind_method(D_METHOD("destroy"), &Terrain3DNavigation::destroy);
+
+	ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &Terrain3DNavigation::set_enabled);
+	ClassDB::bind_method(D_METHOD("is_enabled"), &Terrain3DNavigation::is_enabled);
+	ClassDB::bind_method(D_METHOD("set_template", "template"), &Terrain3DNavigation::set_template);
+	ClassDB::bind_method(D_METHOD("get_template"), &Terrain3DNavigation::get_template);
+	ClassDB::bind_method(D_METHOD("set_tile_size", "size"), &Terrain3DNavigation::set_tile_size);
+	ClassDB::bind_method(D_METHOD("get_tile_size"), &Terrain3DNavigation::get_tile_size);
+	ClassDB::bind_method(D_METHOD("set_radius", "radius"), &Terrain3DNavigation::set_radius);
+	ClassDB::bind_method(D_METHOD("get_radius"), &Terrain3DNavigation::get_radius);
+	ClassDB::bind_method(D_METHOD("set_layers", "layers"), &Terrain3DNavigation::set_layers);
+	ClassDB::bind_method(D_METHOD("get_layers"), &Terrain3DNavigation::get_layers);
+	ClassDB::bind_method(D_METHOD("set_require_nav", "require_nav"), &Terrain3DNavigation::set_require_nav);
+	ClassDB::bind_method(D_METHOD("get_require_nav"), &Terrain3DNavigation::get_require_nav);
+	ClassDB::bind_method(D_METHOD("set_instances", "enabled"), &Terrain3DNavigation::set_instances);
+	ClassDB::bind_method(D_METHOD("get_instances"), &Terrain3DNavigation::get_instances);
+	ClassDB::bind_method(D_METHOD("get_tile_count"), &Terrain3DNavigation::get_tile_count);
+	ClassDB::bind_method(D_METHOD("is_baking"), &Terrain3DNavigation::is_baking);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "template", PROPERTY_HINT_RESOURCE_TYPE, "NavigationMesh"), "set_template", "get_template");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tile_size", PROPERTY_HINT_RANGE, "8,1024,1"), "set_tile_size", "get_tile_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "radius", PROPERTY_HINT_RANGE, "0,8192,1"), "set_radius", "get_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "layers", PROPERTY_HINT_LAYERS_3D_NAVIGATION), "set_layers", "get_layers");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "require_nav"), "set_require_nav", "get_require_nav");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "instances"), "set_instances", "get_instances");
+}
@@ -0,0 +1,94 @@
+// Copyright © 2023-2026 Cory Petkovsek, Roope Palmroos, and Contributors.
+
+#ifndef TERRAIN3D_NAVIGATION_CLASS_H
+#define TERRAIN3D_NAVIGATION_CLASS_H
+
+#include <godot_cpp/classes/navigation_mesh.hpp>
+#include <unordered_map>
+
+#include "constants.h"
+#include "terrain_3d_util.h"
+
+class Terrain3D;
+
+class Terrain3DNavigation : public Object {
+	GDCLASS(Terrain3DNavigation, Object);
+	CLASS_NAME();
+
+public: // Constants
+	// Bakes in flight. Only the NavigationServer bake runs in the background. Each bake first gathers its
+	// source geometry synchronously on the physics thread, reading the maps of a tile plus its border, and
+	// with instances, generating obstacle faces. So this also caps the bakes started per physics frame.
+	static inline const int MAX_BAKE_JOBS = 2;
+
+private:
+	Terrain3D *_terrain = nullptr;
+
+	// Public settings
+	bool _enabled = false;
+	Ref<NavigationMesh> _template;
+	real_t _tile_size = 64.f;
+	real_t _radius = 192.f;
+	uint32_t _layers = 1;
+	bool _require_nav = true;
+	bool _instances = false;
+
+	// Work data
+	// A tile is rebaked while its version differs from the version of its last finished bake. Versions come
+	// from one counter, so bakes finishing after their tile was freed and recreated are recognized as stale.
+	struct Tile {
+		RID region;
+		uint32_t version = 0;
+		uint32_t baked_version = 0;
+		uint32_t baking_version = 0; // Version being baked, or 0 if idle
+	};
+	std::unordered_map<Vector2i, Tile, Vector2iHash> _tiles;
+	uint32_t _version_counter = 0;
+	int _active_jobs = 0; // Bakes in flight, including those of freed tiles
+	bool _initialized = false;
+	Vector2i _last_center = V2I_MAX;
+
+	Vector2i _get_tile(const Vector3 &p_global_position) const;
+	AABB _get_tile_aabb(const Vector2i &p_tile) const;
+	real_t _get_border_size() const;
+	void _update_tiles(const Vector2i &p_center);
+	void _bake_tile(const Vector2i &p_tile, Tile &r_tile);
+	static void _on_tile_baked_id(const uint64_t p_instance_id, const Vector2i &p_tile, const uint32_t p_version,
+			const Ref<NavigationMesh> &p_nav_mesh);
+	void _on_tile_baked(const Vector2i &p_tile, const uint32_t p_version, const Ref<NavigationMesh> &p_nav_mesh);
+	void _free_tile(Tile &r_tile);
+
+public:
+	Terrain3DNavigation() {}
+	~Terrain3DNavigation() { destroy(); }
+	void initialize(Terrain3D *p_terrain);
+
+	void build();
+	void update();
+	void invalidate(const AABB &p_global_aabb);
+	void rebake();
+	void destroy();
+
+	void set_enabled(const bool p_enabled);
+	bool is_enabled() const { return _enabled; }
+	void set_template(const Ref<NavigationMesh> &p_template);
+	Ref<NavigationMesh> get_template() const { return _template; }
+	void set_tile_size(const real_t p_size);
+	real_t get_tile_size() const { return _tile_size; }
+	void set_radius(const real_t p_radius);
+	real_t get_radius() const { return _radius; }
+	void set_layers(const uint32_t p_layers);
+	uint32_t get_layers() const { return _layers; }
+	void set_require_nav(const bool p_require_nav);
+	bool get_require_nav() const { return _require_nav; }
+	void set_instances(const bool p_enabled);
+	bool get_instances() const { return _instances; }
+
+	int get_tile_count() const { return int(_tiles.size()); }
+	bool is_baking() const { return _active_jobs > 0; }
+
+protected:
+	static void _bind_methods();
+};
+
+#endif // TERRAIN3D_NAVIGATION_CLASS_H
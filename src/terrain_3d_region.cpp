@@ -24,6 +24,7 @@ void Terrain3DRegion::clear() {
 	_edited = false;
 	_modified = false;
 	_location = V2I_MAX;
+	_min_heights_dirty = true;
 }
 
 void Terrain3DRegion::set_version(const real_t p_version) {
@@ -133,6 +134,7 @@ void Terrain3DRegion::set_height_map(const Ref<Image> &p_map) {
 		_modified = true;
 	}
 	_height_map = map;
+	_min_heights_dirty = true;
 	calc_height_range();
 }
 
@@ -148,6 +150,7 @@ void Terrain3DRegion::set_control_map(const Ref<Image> &p_map) {
 		_modified = true;
 	}
 	_control_map = map;
+	_min_heights_dirty = true;
 }
 
 void Terrain3DRegion::set_color_map(const Ref<Image> &p_map) {
@@ -261,6 +264,7 @@ void Terrain3DRegion::set_height_range(const Vector2 &p_range) {
 }
 
 void Terrain3DRegion::calc_height_range() {
+	_min_heights_dirty = true;
 	Vector2 range = Util::get_min_max(_height_map);
 	if (_height_range != range) {
 		_height_range = range;
@@ -293,6 +297,127 @@ void Terrain3DRegion::set_location(const Vector2i &p_location) {
 	LOG(INFO, "Set location: ", p_location);
 }
 
+// Returns the minimum height and height bounds pyramids, building them if the maps have changed since the
+// last build, or nullptr if the maps aren't ready. Safe to call from multiple threads; the first caller
+// builds them and the rest wait. Keep the returned pointer while reading.
+std::shared_ptr<const Terrain3DRegion::HeightPyramids> Terrain3DRegion::get_height_pyramids() {
+	std::lock_guard<std::mutex> lock(_min_heights_mutex);
+	if (!_min_heights_dirty) {
+		return _height_pyramids;
+	}
+	_min_heights_dirty = false;
+	if (_height_map.is_null() || _control_map.is_null() || _region_size <= 1 ||
+			_height_map->get_format() != FORMAT[TYPE_HEIGHT] || _control_map->get_format() != FORMAT[TYPE_CONTROL] ||
+			_height_map->get_width() != _region_size || _control_map->get_width() != _region_size) {
+		LOG(WARN, "Region ", _location, " maps are not ready. Skipping minimum height build");
+		_height_pyramids.reset();
+		return _height_pyramids;
+	}
+	LOG(EXTREME, "Building minimum height levels for region ", _location);
+	const float *heights = reinterpret_cast<const float *>(_height_map->ptr());
+	const float *controls = reinterpret_cast<const float *>(_control_map->ptr());
+	auto height_at = [&](const int64_t p_index) -> float {
+		return is_hole(controls[p_index]) ? NAN : heights[p_index];
+	};
+	std::shared_ptr<HeightPyramids> pyramids = std::make_shared<HeightPyramids>();
+
+	// Level 1 reads the maps, so level 0 isn't stored
+	const int size1 = _region_size / 2;
+	std::vector<float> level1(int64_t(size1) * size1);
+	for (int y = 0; y < size1; y++) {
+		for (int x = 0; x < size1; x++) {
+			const int64_t i = int64_t(y * 2) * _region_size + x * 2;
+			const float h00 = height_at(i);
+			const float h10 = height_at(i + 1);
+			const float h01 = height_at(i + _region_size);
+			const float h11 = height_at(i + _region_size + 1);
+			// NAN propagates: a block containing a hole has no minimum
+			if (std::isnan(h00) || std::isnan(h10) || std::isnan(h01) || std::isnan(h11)) {
+				level1[int64_t(y) * size1 + x] = NAN;
+			} else {
+				level1[int64_t(y) * size1 + x] = MIN(MIN(h00, h10), MIN(h01, h11));
+			}
+		}
+	}
+	std::vector<std::vector<float>> &levels = pyramids->min_heights;
+	levels.push_back(std::move(level1));
+	for (int size = size1 / 2; size >= 1; size /= 2) {
+		const std::vector<float> &prev = levels.back();
+		const int prev_size = size * 2;
+		std::vector<float> next(int64_t(size) * size);
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				const int64_t i = int64_t(y * 2) * prev_size + x * 2;
+				const float h00 = prev[i];
+				const float h10 = prev[i + 1];
+				const float h01 = prev[i + prev_size];
+				const float h11 = prev[i + prev_size + 1];
+				if (std::isnan(h00) || std::isnan(h10) || std::isnan(h01) || std::isnan(h11)) {
+					next[int64_t(y) * size + x] = NAN;
+				} else {
+					next[int64_t(y) * size + x] = MIN(MIN(h00, h10), MIN(h01, h11));
+				}
+			}
+		}
+		levels.push_back(std::move(next));
+	}
+
+	// fmin and fmax ignore NAN, so holes are skipped
+	std::vector<std::vector<Vector2>> &bounds = pyramids->height_bounds;
+	const int bounds_block = 1 << HEIGHT_BOUNDS_LEVEL;
+	const int bounds_size = _region_size / bounds_block;
+	std::vector<Vector2> bounds_level(int64_t(bounds_size) * bounds_size, V2(NAN));
+	for (int y = 0; y < _region_size; y++) {
+		for (int x = 0; x < _region_size; x++) {
+			const float h = height_at(int64_t(y) * _region_size + x);
+			Vector2 &b = bounds_level[int64_t(y / bounds_block) * bounds_size + x / bounds_block];
+			b.x = std::fmin(b.x, h);
+			b.y = std::fmax(b.y, h);
+		}
+	}
+	bounds.push_back(std::move(bounds_level));
+	for (int size = bounds_size / 2; size >= 1; size /= 2) {
+		const std::vector<Vector2> &prev = bounds.back();
+		const int prev_size = size * 2;
+		std::vector<Vector2> next(int64_t(size) * size);
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				const int64_t i = int64_t(y * 2) * prev_size + x * 2;
+				const Vector2 &b00 = prev[i];
+				const Vector2 &b10 = prev[i + 1];
+				const Vector2 &b01 = prev[i + prev_size];
+				const Vector2 &b11 = prev[i + prev_size + 1];
+				next[int64_t(y) * size + x] = Vector2(
+						std::fmin(std::fmin(b00.x, b10.x), std::fmin(b01.x, b11.x)),
+						std::fmax(std::fmax(b00.y, b10.y), std::fmax(b01.y, b11.y)));
+			}
+		}
+		bounds.push_back(std::move(next));
+	}
+	_height_pyramids = std::move(pyramids);
+	return _height_pyramids;
+}
+
+// Returns level p_level of the minimum height pyramid, (region_size >> p_level)^2 floats, or nullptr if
+// unavailable or level 0.
+const float *Terrain3DRegion::HeightPyramids::get_min_heights(const int p_level) const {
+	const int index = p_level - 1;
+	if (index < 0 || index >= int(min_heights.size())) {
+		return nullptr;
+	}
+	return min_heights[index].data();
+}
+
+// Returns level p_level of the height bounds pyramid, (region_size >> p_level)^2 Vector2(min, max), or
+// nullptr if unavailable or below HEIGHT_BOUNDS_LEVEL.
+const Vector2 *Terrain3DRegion::HeightPyramids::get_height_bounds(const int p_level) const {
+	const int index = p_level - HEIGHT_BOUNDS_LEVEL;
+	if (index < 0 || index >= int(height_bounds.size())) {
+		return nullptr;
+	}
+	return height_bounds[index].data();
+}
+
 Error Terrain3DRegion::save(const String &p_path, const bool p_16_bit) {
 	// Initiate save to external file. The scene will save itself.
 	if (_location.x == INT32_MAX) {
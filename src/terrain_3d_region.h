@@ -5,6 +5,11 @@
 
 #include <godot_cpp/classes/image.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "constants.h"
 #include "terrain_3d_util.h"
 
@@ -41,6 +46,21 @@ public: // Constants
 		COLOR_NAN, // TYPE_MAX, unused just in case someone indexes the array
 	};
 
+	// Finest level of the height bounds pyramid, in 16 pixel blocks
+	static inline const int HEIGHT_BOUNDS_LEVEL = 4;
+
+	// Minimum height pyramid for HEIGHT_FILTER_MINIMUM, from level 1 up. Level n holds the lowest height of
+	// each 2^n square block, or NAN if the block contains a hole. Level 0 is read from the maps.
+	// Height bounds pyramid for culling, from HEIGHT_BOUNDS_LEVEL up. Holds the lowest and highest heights of
+	// each block, ignoring holes, or NAN if the block is all holes.
+	struct HeightPyramids {
+		std::vector<std::vector<float>> min_heights;
+		std::vector<std::vector<Vector2>> height_bounds;
+
+		const float *get_min_heights(const int p_level) const;
+		const Vector2 *get_height_bounds(const int p_level) const;
+	};
+
 private:
 	// Saved data
 	real_t _version = 0.8f; // Set to first version to ensure we always upgrades this
@@ -59,6 +79,11 @@ private:
 	bool _edited = false; // Marked for undo/redo storage
 	bool _modified = false; // Marked for saving
 	Vector2i _location = V2I_MAX;
+	// Built on demand and rebuilt after the height or control maps change. Each build is published as a new
+	// object, so readers holding the previous one can finish with it.
+	std::shared_ptr<const HeightPyramids> _height_pyramids;
+	std::atomic<bool> _min_heights_dirty = true;
+	std::mutex _min_heights_mutex;
 
 public:
 	Terrain3DRegion() {}
@@ -107,6 +132,8 @@ public:
 	bool is_modified() const { return _modified; }
 	void set_location(const Vector2i &p_location);
 	Vector2i get_location() const { return _location; }
+	void mark_min_heights_dirty() { _min_heights_dirty = true; }
+	std::shared_ptr<const HeightPyramids> get_height_pyramids();
 
 	// File I/O
 	Error save(const String &p_path = "", const bool p_16_bit = false);
@@ -4,6 +4,7 @@
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/time.hpp>
+#include <vector>
 
 #include "logger.h"
 #include "terrain_3d_util.h"
@@ -151,6 +152,8 @@ Ref<Image> Terrain3DUtil::black_to_alpha(const Ref<Image> &p_image) {
 
 /**
  * Returns the minimum and maximum values for a heightmap (red channel only)
+ * FORMAT_RF images are scanned directly from the buffer, split across the WorkerThreadPool when large.
+ * NaNs are skipped.
  */
 Vector2 Terrain3DUtil::get_min_max(const Ref<Image> &p_image) {
 	if (p_image.is_null()) {
@@ -163,14 +166,32 @@ Vector2 Terrain3DUtil::get_min_max(const Ref<Image> &p_image) {
 
 	Vector2 min_max = Vector2(FLT_MAX, -FLT_MAX);
 
-	for (int y = 0; y < p_image->get_height(); y++) {
-		for (int x = 0; x < p_image->get_width(); x++) {
-			Color col = p_image->get_pixel(x, y);
-			if (col.r < min_max.x) {
-				min_max.x = col.r;
-			}
-			if (col.r > min_max.y) {
-				min_max.y = col.r;
+	if (p_image->get_format() == Image::FORMAT_RF) {
+		// Mipmaps follow the full sized image in the buffer, so only read the first level
+		const float *data = reinterpret_cast<const float *>(p_image->ptr());
+		const int64_t count = int64_t(p_image->get_width()) * int64_t(p_image->get_height());
+		// A 2048 region is one chunk, so regions processed in parallel don't nest pool tasks
+		const int64_t CHUNK_SIZE = 2048 * 2048;
+		const int chunks = int((count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+		std::vector<Vector2> results(chunks);
+		parallel_for(chunks, [&](const int p_chunk) {
+			int64_t start = int64_t(p_chunk) * CHUNK_SIZE;
+			results[p_chunk] = get_min_max_buffer(data + start, MIN(CHUNK_SIZE, count - start));
+		});
+		for (const Vector2 &result : results) {
+			min_max.x = MIN(min_max.x, result.x);
+			min_max.y = MAX(min_max.y, result.y);
+		}
+	} else {
+		for (int y = 0; y < p_image->get_height(); y++) {
+			for (int x = 0; x < p_image->get_width(); x++) {
+				Color col = p_image->get_pixel(x, y);
+				if (col.r < min_max.x) {
+					min_max.x = col.r;
+				}
+				if (col.r > min_max.y) {
+					min_max.y = col.r;
+				}
 			}
 		}
 	}
@@ -179,6 +200,44 @@ Vector2 Terrain3DUtil::get_min_max(const Ref<Image> &p_image) {
 	return min_max;
 }
 
+/**
+ * Returns the minimum and maximum values of a raw float buffer, skipping NaNs
+ * Lanes are accumulated independently so the compiler can emit SIMD min/max instructions.
+ * The ternaries map directly to minps/maxps, which return the second operand on NaN.
+ */
+Vector2 Terrain3DUtil::get_min_max_buffer(const float *p_data, const int64_t p_count) {
+	const int LANES = 8;
+	float lane_min[LANES];
+	float lane_max[LANES];
+	for (int l = 0; l < LANES; l++) {
+		lane_min[l] = FLT_MAX;
+		lane_max[l] = -FLT_MAX;
+	}
+	if (!p_data || p_count <= 0) {
+		return Vector2(FLT_MAX, -FLT_MAX);
+	}
+	const int64_t lanes_end = p_count - p_count % LANES;
+	int64_t i = 0;
+	for (; i < lanes_end; i += LANES) {
+		for (int l = 0; l < LANES; l++) {
+			const float value = p_data[i + l];
+			lane_min[l] = (value < lane_min[l]) ? value : lane_min[l];
+			lane_max[l] = (value > lane_max[l]) ? value : lane_max[l];
+		}
+	}
+	for (; i < p_count; i++) {
+		const float value = p_data[i];
+		lane_min[0] = (value < lane_min[0]) ? value : lane_min[0];
+		lane_max[0] = (value > lane_max[0]) ? value : lane_max[0];
+	}
+	Vector2 min_max = Vector2(lane_min[0], lane_max[0]);
+	for (int l = 1; l < LANES; l++) {
+		min_max.x = MIN(min_max.x, lane_min[l]);
+		min_max.y = MAX(min_max.y, lane_max[l]);
+	}
+	return min_max;
+}
+
 /**
  * Returns a Image of a float heightmap normalized to RGB8 greyscale and scaled
  * Minimum of 8x8
@@ -194,10 +253,17 @@ Ref<Image> Terrain3DUtil::get_thumbnail(const Ref<Image> &p_image, const Vector2
 	Vector2i size = Vector2i(CLAMP(p_size.x, 8, 16384), CLAMP(p_size.y, 8, 16384));
 
 	LOG(INFO, "Drawing a thumbnail sized: ", size);
-	// Create a temporary work image scaled to desired width
+	// Create a temporary work image scaled to desired width, in RF so we can read the buffer directly
 	Ref<Image> img;
 	img.instantiate();
 	img->copy_from(p_image);
+	if (img->is_compressed()) {
+		img->decompress();
+	}
+	img->clear_mipmaps();
+	if (img->get_format() != Image::FORMAT_RF) {
+		img->convert(Image::FORMAT_RF);
+	}
 	img->resize(size.x, size.y, Image::INTERPOLATE_LANCZOS);
 
 	// Get minimum and maximum height values on the scaled image
@@ -211,17 +277,19 @@ Ref<Image> Terrain3DUtil::get_thumbnail(const Ref<Image> &p_image, const Vector2
 	hmax = (hmax == 0) ? 0.001f : hmax;
 
 	// Create a new image w / normalized values
-	Ref<Image> thumb = Image::create_empty(size.x, size.y, false, Image::FORMAT_RGB8);
-	for (int y = 0; y < thumb->get_height(); y++) {
-		for (int x = 0; x < thumb->get_width(); x++) {
-			Color col = img->get_pixel(x, y);
-			col.r = (col.r + hmin) / hmax;
-			col.g = col.r;
-			col.b = col.r;
-			thumb->set_pixel(x, y, col);
-		}
-	}
-	return thumb;
+	PackedByteArray thumb_data;
+	thumb_data.resize(int64_t(size.x) * size.y * 3);
+	const float *src = reinterpret_cast<const float *>(img->ptr());
+	uint8_t *dst = thumb_data.ptrw();
+	const int64_t count = int64_t(size.x) * size.y;
+	for (int64_t i = 0; i < count; i++) {
+		float height = std::isnan(src[i]) ? 0.f : src[i];
+		uint8_t value = uint8_t(CLAMP(Math::round((height + hmin) / hmax * 255.f), 0.f, 255.f));
+		dst[i * 3 + 0] = value;
+		dst[i * 3 + 1] = value;
+		dst[i * 3 + 2] = value;
+	}
+	return Image::create_from_data(size.x, size.y, false, Image::FORMAT_RGB8, thumb_data);
 }
 
 /* Get an Image filled with specified color and format
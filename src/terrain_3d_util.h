@@ -6,6 +6,7 @@
 #include <godot_cpp/classes/image.hpp>
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
 #include "constants.h"
@@ -39,6 +40,7 @@ public:
 	// Image operations
 	static Ref<Image> black_to_alpha(const Ref<Image> &p_image);
 	static Vector2 get_min_max(const Ref<Image> &p_image);
+	static Vector2 get_min_max_buffer(const float *p_data, const int64_t p_count);
 	static Ref<Image> get_thumbnail(const Ref<Image> &p_image, const Vector2i &p_size = V2I(256));
 	static Ref<Image> get_filled_image(const Vector2i &p_size,
 			const Color &p_color = COLOR_BLACK,
@@ -274,6 +276,60 @@ inline bool is_auto(const float p_pixel) { return is_auto(as_uint(p_pixel)); }
 inline uint32_t enc_auto(const bool p_auto) { return p_auto & 0x1; }
 inline bool gd_is_auto(const uint32_t p_pixel) { return is_auto(p_pixel); }
 
+///////////////////////////
+// Image Buffers
+///////////////////////////
+
+// Reads p_count floats every p_stride floats from p_src, applies p_scale then p_offset, and writes them packed
+// to p_dst. Non-normal values (0, subnormal, inf, NaN) become p_offset, matching std::isnormal.
+// The normal test is done on the exponent bits so the loop stays branch free and can be vectorized.
+inline void scale_offset_heights(const float *p_src, const int64_t p_stride, float *p_dst, const int64_t p_count,
+		const float p_scale, const float p_offset) {
+	for (int64_t i = 0; i < p_count; i++) {
+		const float value = p_src[i * p_stride];
+		const uint32_t exponent = as_uint(value) & 0x7F800000;
+		p_dst[i] = (exponent != 0 && exponent != 0x7F800000) ? value * p_scale + p_offset : p_offset;
+	}
+}
+
+// Writes p_xform to p_dst as the 12 floats of a MULTIMESH_TRANSFORM_3D buffer entry: the rows of the 3x4
+// matrix. Filling a buffer and sending it with multimesh_set_buffer() is one server command, rather than
+// one per instance.
+inline void write_multimesh_transform(float *p_dst, const Transform3D &p_xform) {
+	for (int row = 0; row < 3; row++) {
+		p_dst[row * 4 + 0] = p_xform.basis.rows[row].x;
+		p_dst[row * 4 + 1] = p_xform.basis.rows[row].y;
+		p_dst[row * 4 + 2] = p_xform.basis.rows[row].z;
+		p_dst[row * 4 + 3] = p_xform.origin[row];
+	}
+}
+
+///////////////////////////
+// Threading
+///////////////////////////
+
+// Calls p_func(index) for index 0 to p_count - 1 on the WorkerThreadPool and blocks until all are done.
+// Each index must touch independent data. If already called from a pool task, eg. a script baking
+// navigation on a thread, it runs serially, as waiting on nested groups can starve the pool.
+template <typename F>
+inline void parallel_for(const int p_count, const F &p_func, const String &p_description = "Terrain3D") {
+	if (p_count <= 0) {
+		return;
+	}
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	if (p_count == 1 || wtp->get_caller_task_id() >= 0 || wtp->get_caller_group_id() >= 0) {
+		for (int i = 0; i < p_count; i++) {
+			p_func(i);
+		}
+		return;
+	}
+	auto task = [](void *p_userdata, uint32_t p_index) {
+		(*static_cast<const F *>(p_userdata))(int(p_index));
+	};
+	WorkerThreadPool::GroupID group_id = wtp->add_native_group_task(task, (void *)&p_func, p_count, -1, true, p_description);
+	wtp->wait_for_group_task_completion(group_id);
+}
+
 ///////////////////////////
 // Memory
 ///////////////////////////
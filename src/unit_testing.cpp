@@ -1,7 +1,11 @@
 // Copyright © 2023-2026 Cory Petkovsek, Roope Palmroos, and Contributors.
 
-#include "unit_testing.h"
+#include <algorithm>
+#include <cmath>
+
+#include "terrain_3d.h"
 #include "terrain_3d_util.h"
+#include "unit_testing.h"
 
 void test_differs() {
 	UtilityFunctions::print("=== Testing differs function ===");
@@ -166,4 +170,135 @@ void test_differs() {
 	}
 
 	UtilityFunctions::print("=== End differs tests ===");
-}
\ No newline at end of file
+}
+
+void test_triangulate_rtin() {
+	UtilityFunctions::print("=== Testing _triangulate_rtin ===");
+	const int32_t size = 16;
+	const int32_t grid = size + 1;
+	const std::vector<uint8_t> tris(size * size, 0x3);
+
+	// Returns the triangle count for a flat grid with a 10m bump, and whether the bump vertex is used
+	auto triangulate = [&](const int32_t p_x, const int32_t p_z, bool &r_has_bump) -> int64_t {
+		std::vector<float> heights(grid * grid, 0.f);
+		heights[p_z * grid + p_x] = 10.f;
+		std::vector<int32_t> triangles;
+		Terrain3D::_triangulate_rtin(triangles, size, heights, tris, 0.5f);
+		r_has_bump = std::find(triangles.begin(), triangles.end(), p_z * grid + p_x) != triangles.end();
+		return int64_t(triangles.size()) / 3;
+	};
+
+	// Flat grids are simplified inside, keeping only the perimeter at full resolution
+	std::vector<int32_t> flat_triangles;
+	Terrain3D::_triangulate_rtin(flat_triangles, size, std::vector<float>(grid * grid, 0.f), tris, 0.5f);
+	UtilityFunctions::print("Flat triangles: ", int64_t(flat_triangles.size()) / 3, " of ", size * size * 2);
+	EXPECT_TRUE(flat_triangles.size() / 3 < size_t(size * size * 2));
+
+	// Features on either side of the diagonal are kept, and mirrored features give the same triangle count
+	bool lower_has_bump = false;
+	bool upper_has_bump = false;
+	const int64_t lower_count = triangulate(12, 3, lower_has_bump); // x > z
+	const int64_t upper_count = triangulate(3, 12, upper_has_bump); // x < z
+	UtilityFunctions::print("Bump triangles, x > z: ", lower_count, ", x < z: ", upper_count);
+	EXPECT_TRUE(lower_has_bump);
+	EXPECT_TRUE(upper_has_bump);
+	EXPECT_TRUE(upper_count > 2);
+	EXPECT_TRUE(upper_count == lower_count);
+
+	// Adjacent grids simplified separately use the same vertices along their shared edge, even with a bump
+	// near it on one side only
+	std::vector<int32_t> edge_rows[2];
+	for (int tile = 0; tile < 2; tile++) {
+		std::vector<float> heights(grid * grid, 0.f);
+		if (tile == 0) {
+			heights[5 * grid + size - 3] = 10.f;
+		}
+		std::vector<int32_t> triangles;
+		Terrain3D::_triangulate_rtin(triangles, size, heights, tris, 0.5f);
+		const int32_t edge_x = (tile == 0) ? size : 0;
+		for (const int32_t index : triangles) {
+			if (index % grid == edge_x) {
+				edge_rows[tile].push_back(index / grid);
+			}
+		}
+		std::sort(edge_rows[tile].begin(), edge_rows[tile].end());
+		edge_rows[tile].erase(std::unique(edge_rows[tile].begin(), edge_rows[tile].end()), edge_rows[tile].end());
+	}
+	EXPECT_TRUE(edge_rows[0] == edge_rows[1]);
+
+	UtilityFunctions::print("=== End _triangulate_rtin tests ===");
+}
+
+void test_get_mesh_vertex() {
+	UtilityFunctions::print("=== Testing get_mesh_vertex ===");
+	const int32_t region_size = 64;
+	Terrain3DData *data = memnew(Terrain3DData);
+	data->_region_size = region_size;
+	data->_region_sizev = V2I(region_size);
+	data->_region_map.resize(Terrain3DData::REGION_MAP_SIZE * Terrain3DData::REGION_MAP_SIZE);
+	data->_region_map.fill(0);
+
+	// Two regions side by side with uneven heights, and a hole near their shared edge
+	const Vector2i hole = Vector2i(70, 20);
+	for (int i = 0; i < 2; i++) {
+		const Vector2i region_loc = Vector2i(i, 0);
+		Ref<Terrain3DRegion> region = data->add_region_blank(region_loc, false);
+		data->_region_map[Terrain3DData::get_region_map_index(region_loc)] = i + 1;
+		Image *height_map = region->get_map_ptr(TYPE_HEIGHT);
+		Image *control_map = region->get_map_ptr(TYPE_CONTROL);
+		for (int32_t y = 0; y < region_size; y++) {
+			for (int32_t x = 0; x < region_size; x++) {
+				const Vector2i pos = region_loc * region_size + Vector2i(x, y);
+				height_map->set_pixel(x, y, Color(real_t((pos.x * 37 + pos.y * 91) % 113), 0.f, 0.f, 1.f));
+				if (pos == hole) {
+					control_map->set_pixel(x, y, Color(as_float(enc_hole(true)), 0.f, 0.f, 1.f));
+				}
+			}
+		}
+	}
+
+	// Lowest height in the window [pos - step/2, pos + step/2), or NAN with any hole or missing region
+	auto scan = [&](const Vector2i &p_pos, const int32_t p_step) -> real_t {
+		real_t height = FLT_MAX;
+		for (int32_t z = p_pos.y - p_step / 2; z < p_pos.y + p_step / 2; z++) {
+			for (int32_t x = p_pos.x - p_step / 2; x < p_pos.x + p_step / 2; x++) {
+				const real_t h = data->get_height(Vector3(x, 0.f, z));
+				if (std::isnan(h)) {
+					return NAN;
+				}
+				height = MIN(height, h);
+			}
+		}
+		return height;
+	};
+
+	// Vertices on each lod grid, and a few off it
+	int checked = 0;
+	int mismatched = 0;
+	for (int32_t lod = 1; lod <= 5; lod++) {
+		const int32_t step = 1 << lod;
+		for (int32_t z = 0; z <= region_size; z += step) {
+			for (int32_t x = 0; x <= region_size * 2; x += step) {
+				for (const Vector2i &pos : { Vector2i(x, z), Vector2i(x + 3, z + 1) }) {
+					const real_t expected = scan(pos, step);
+					const real_t height = data->get_mesh_vertex(lod, Terrain3DData::HEIGHT_FILTER_MINIMUM, Vector3(pos.x, 0.f, pos.y)).y;
+					if (std::isnan(expected) != std::isnan(height) || (!std::isnan(expected) && expected != height)) {
+						mismatched++;
+					}
+					checked++;
+				}
+			}
+		}
+	}
+	UtilityFunctions::print("Vertices checked: ", checked, ", mismatched: ", mismatched);
+	EXPECT_TRUE(mismatched == 0);
+
+	// A hole just outside of the window doesn't affect the vertex
+	const Vector3 beside_hole = Vector3(hole.x - 4, 0.f, hole.y + 4);
+	EXPECT_FALSE(std::isnan(data->get_mesh_vertex(3, Terrain3DData::HEIGHT_FILTER_MINIMUM, beside_hole).y));
+	EXPECT_TRUE(std::isnan(data->get_mesh_vertex(3, Terrain3DData::HEIGHT_FILTER_MINIMUM, Vector3(hole.x, 0.f, hole.y)).y));
+	EXPECT_TRUE(std::isnan(data->get_min_height(Rect2i(hole, V2I(1)))));
+
+	memdelete(data);
+	UtilityFunctions::print("=== End get_mesh_vertex tests ===");
+}
@@ -22,5 +22,7 @@
 	} while (0)
 
 void test_differs();
+void test_triangulate_rtin();
+void test_get_mesh_vertex();
 
 #endif // UNIT_TESTING_H